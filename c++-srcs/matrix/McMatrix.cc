@@ -41,29 +41,36 @@ McColComp::operator()(
 McMatrix::McMatrix(
   SizeType row_size,
   const vector<SizeType>& cost_array,
-  const vector<ElemType>& elem_list
-) : mRowSize{row_size},
+  const vector<ElemType>& elem_list,
+  bool compact
+) : mCompact{compact},
+    mRowSize{row_size},
     mRowHeadArray(mRowSize),
-    mRowArray(mRowSize, nullptr),
     mColSize{cost_array.size()},
     mColHeadArray(mColSize),
-    mColArray(mColSize, nullptr),
     mCostArray{cost_array},
     mDelStack(mRowSize + mColSize),
+    mRowMark(mRowSize, 0),
+    mColMark(mColSize, 0),
     mDelList(std::max(mRowSize, mColSize))
 {
+  mRowWorkList.reserve(mRowSize);
+  mColWorkList.reserve(mColSize);
   for ( auto row_pos: Range(mRowSize) ) {
     mRowHeadArray[row_pos].init(row_pos, false);
-    mRowArray[row_pos] = alloc_cell(row_pos, -1);
   }
-
   for ( auto col_pos: Range(mColSize) ) {
     mColHeadArray[col_pos].init(col_pos, true);
-    mColArray[col_pos] = alloc_cell(-1, col_pos);
   }
 
+  // ダミーセルを作る．
+  init_dummies(elem_list.size());
+
+  // シグネチャとビットベクタを用意する．
+  init_bits();
+
   // 要素を設定する．
-  insert_elem_list(elem_list);
+  build(elem_list);
 }
 
 #if 0
@@ -107,6 +114,16 @@ McMatrix::insert_elem(
   auto row_pos = elem.row_pos;
   auto col_pos = elem.col_pos;
 
+  // 要素の追加は通知できないので McObserver の登録は外す．
+  if ( !mObserverList.empty() ) {
+    mObserverList.clear();
+  }
+
+  if ( mCompact ) {
+    insert_elem_compact(row_pos, col_pos);
+    return;
+  }
+
   // 行方向の挿入位置を求める．
   auto row_head = &mRowHeadArray[row_pos];
   auto row_dummy = mRowArray[row_pos];
@@ -139,9 +156,11 @@ McMatrix::insert_elem(
   pcell->mRightLink = cell;
   cell->mRightLink = ncell;
   ncell->mLeftLink = cell;
-  row_head->inc_num();
+  inc_row_num(row_pos);
+  mRowBits.set(row_pos, col_pos);
   if ( row_head->num() == 1 ) {
     mRowHeadList.insert(row_head);
+    mHash ^= row_key(row_pos);
   }
 
   // 列方向の挿入位置を求める．
@@ -173,9 +192,94 @@ McMatrix::insert_elem(
   pcell->mDownLink = cell;
   cell->mDownLink = ncell;
   ncell->mUpLink = cell;
-  col_head->inc_num();
+  inc_col_num(col_pos);
+  mColBits.set(col_pos, row_pos);
+  if ( col_head->num() == 1 ) {
+    mColHeadList.insert(col_head);
+    mHash ^= col_key(col_pos);
+  }
+}
+
+// @brief コンパクトモードで要素を追加する．
+void
+McMatrix::insert_elem_compact(
+  SizeType row_pos,
+  SizeType col_pos
+)
+{
+  auto& cells = mCellArray;
+
+  // 行方向の挿入位置を求める．
+  auto row_head = &mRowHeadArray[row_pos];
+  auto row_dummy = row_dummy_id(row_pos);
+  McCellArray::IndexType pid;
+  McCellArray::IndexType nid;
+  if ( row_head->num() == 0 || cells.col_pos(cells.row_prev(row_dummy)) < col_pos ) {
+    // 末尾への追加
+    nid = row_dummy;
+    pid = cells.row_prev(nid);
+  }
+  else {
+    // 追加位置を探索
+    for ( pid = row_dummy; ; pid = nid ) {
+      nid = cells.row_next(pid);
+      if ( cells.col_pos(nid) == col_pos ) {
+	// 列番号が重複しているので無視する．
+	return;
+      }
+      if ( cells.col_pos(nid) > col_pos ) {
+	// pid と nid の間に挿入する．
+	break;
+      }
+      ASSERT_COND( nid != row_dummy );
+    }
+  }
+
+  auto id = cells.new_cell(row_pos, col_pos);
+  cells.mLeftArray[id] = pid;
+  cells.mRightArray[pid] = id;
+  cells.mRightArray[id] = nid;
+  cells.mLeftArray[nid] = id;
+  inc_row_num(row_pos);
+  mRowBits.set(row_pos, col_pos);
+  if ( row_head->num() == 1 ) {
+    mRowHeadList.insert(row_head);
+    mHash ^= row_key(row_pos);
+  }
+
+  // 列方向の挿入位置を求める．
+  auto col_head = &mColHeadArray[col_pos];
+  auto col_dummy = col_dummy_id(col_pos);
+  if ( col_head->num() == 0 || cells.row_pos(cells.col_prev(col_dummy)) < row_pos ) {
+    // 末尾への追加
+    nid = col_dummy;
+    pid = cells.col_prev(nid);
+  }
+  else {
+    // 追加位置を探索
+    for ( pid = col_dummy; ; pid = nid ) {
+      nid = cells.col_next(pid);
+      if ( cells.row_pos(nid) == row_pos ) {
+	// 行番号が重複することはないはず．
+	ASSERT_NOT_REACHED;
+	return;
+      }
+      if ( cells.row_pos(nid) > row_pos ) {
+	// pid と nid の間に挿入する．
+	break;
+      }
+      ASSERT_COND( nid != col_dummy );
+    }
+  }
+  cells.mUpArray[id] = pid;
+  cells.mDownArray[pid] = id;
+  cells.mDownArray[id] = nid;
+  cells.mUpArray[nid] = id;
+  inc_col_num(col_pos);
+  mColBits.set(col_pos, row_pos);
   if ( col_head->num() == 1 ) {
     mColHeadList.insert(col_head);
+    mHash ^= col_key(col_pos);
   }
 }
 
@@ -190,18 +294,179 @@ McMatrix::insert_elem_list(
   }
 }
 
+// @brief 空の行列に要素のリストをまとめて設定する．
+void
+McMatrix::build(
+  const vector<ElemType>& elem_list
+)
+{
+  if ( elem_list.empty() ) {
+    return;
+  }
+
+  // 列番号で計数ソートを行い，列ごとの行番号のリストを作る．
+  // col_begin[col_pos] が列 col_pos の先頭位置となる．
+  vector<SizeType> col_begin(mColSize + 1, 0);
+  for ( auto& elem: elem_list ) {
+    ASSERT_COND( elem.row_pos < mRowSize );
+    ASSERT_COND( elem.col_pos < mColSize );
+    ++ col_begin[elem.col_pos + 1];
+  }
+  for ( auto col_pos: Range(mColSize) ) {
+    col_begin[col_pos + 1] += col_begin[col_pos];
+  }
+  vector<SizeType> row_begin(mRowSize + 1, 0);
+  vector<SizeType> row_buff(elem_list.size());
+  {
+    vector<SizeType> wpos(col_begin.begin(), col_begin.end() - 1);
+    for ( auto& elem: elem_list ) {
+      row_buff[wpos[elem.col_pos]] = elem.row_pos;
+      ++ wpos[elem.col_pos];
+      ++ row_begin[elem.row_pos + 1];
+    }
+  }
+
+  // 列の昇順に行番号で振り分けることで，
+  // 行ごとの列番号のリストを列番号順に作る．
+  for ( auto row_pos: Range(mRowSize) ) {
+    row_begin[row_pos + 1] += row_begin[row_pos];
+  }
+  vector<SizeType> col_buff(elem_list.size());
+  {
+    vector<SizeType> wpos(row_begin.begin(), row_begin.end() - 1);
+    for ( auto col_pos: Range(mColSize) ) {
+      for ( auto i: Range(col_begin[col_pos], col_begin[col_pos + 1]) ) {
+	auto row_pos = row_buff[i];
+	col_buff[wpos[row_pos]] = col_pos;
+	++ wpos[row_pos];
+      }
+    }
+  }
+
+  // 行の昇順，列の昇順にセルを作りリンクを張る．
+  // どちらの方向も常に末尾への追加となる．
+  vector<McHead*> row_head_list;
+  row_head_list.reserve(mRowSize);
+  for ( auto row_pos: Range(mRowSize) ) {
+    auto row_head = &mRowHeadArray[row_pos];
+    SizeType prev_col = mColSize;
+    if ( mCompact ) {
+      auto& cells = mCellArray;
+      auto row_dummy = row_dummy_id(row_pos);
+      for ( auto i: Range(row_begin[row_pos], row_begin[row_pos + 1]) ) {
+	auto col_pos = col_buff[i];
+	if ( col_pos == prev_col ) {
+	  // 重複した要素は無視する．
+	  continue;
+	}
+	prev_col = col_pos;
+
+	auto id = cells.new_cell(row_pos, col_pos);
+	auto rprev = cells.row_prev(row_dummy);
+	cells.mLeftArray[id] = rprev;
+	cells.mRightArray[rprev] = id;
+	cells.mRightArray[id] = row_dummy;
+	cells.mLeftArray[row_dummy] = id;
+	inc_row_num(row_pos);
+
+	auto col_dummy = col_dummy_id(col_pos);
+	auto cprev = cells.col_prev(col_dummy);
+	cells.mUpArray[id] = cprev;
+	cells.mDownArray[cprev] = id;
+	cells.mDownArray[id] = col_dummy;
+	cells.mUpArray[col_dummy] = id;
+	inc_col_num(col_pos);
+	mRowBits.set(row_pos, col_pos);
+	mColBits.set(col_pos, row_pos);
+      }
+      if ( row_head->num() > 0 ) {
+	row_head_list.push_back(row_head);
+      }
+      continue;
+    }
+
+    auto row_dummy = mRowArray[row_pos];
+    for ( auto i: Range(row_begin[row_pos], row_begin[row_pos + 1]) ) {
+      auto col_pos = col_buff[i];
+      if ( col_pos == prev_col ) {
+	// 重複した要素は無視する．
+	continue;
+      }
+      prev_col = col_pos;
+
+      auto cell = alloc_cell(row_pos, col_pos);
+      auto rprev = row_dummy->mLeftLink;
+      cell->mLeftLink = rprev;
+      rprev->mRightLink = cell;
+      cell->mRightLink = row_dummy;
+      row_dummy->mLeftLink = cell;
+      inc_row_num(row_pos);
+
+      auto col_dummy = mColArray[col_pos];
+      auto cprev = col_dummy->mUpLink;
+      cell->mUpLink = cprev;
+      cprev->mDownLink = cell;
+      cell->mDownLink = col_dummy;
+      col_dummy->mUpLink = cell;
+      inc_col_num(col_pos);
+      mRowBits.set(row_pos, col_pos);
+      mColBits.set(col_pos, row_pos);
+    }
+    if ( row_head->num() > 0 ) {
+      row_head_list.push_back(row_head);
+    }
+  }
+  mRowHeadList.set(row_head_list);
+  for ( auto row_head: row_head_list ) {
+    mHash ^= row_key(row_head->pos());
+  }
+
+  vector<McHead*> col_head_list;
+  col_head_list.reserve(mColSize);
+  for ( auto col_pos: Range(mColSize) ) {
+    auto col_head = &mColHeadArray[col_pos];
+    if ( col_head->num() > 0 ) {
+      col_head_list.push_back(col_head);
+      mHash ^= col_key(col_pos);
+    }
+  }
+  mColHeadList.set(col_head_list);
+
+  // 全ての行と列が作業リストに入っているので，
+  // 支配される側としてのチェックは不要
+  for ( auto& head: mRowHeadArray ) {
+    head.set_grown(false);
+  }
+  for ( auto& head: mColHeadArray ) {
+    head.set_grown(false);
+  }
+}
+
 // @brief 列 col_pos によって被覆される行を削除し，列も削除する．
 void
 McMatrix::select_col(
   SizeType col_pos
 )
 {
-  for ( auto row_pos: col_list(col_pos) ) {
-    delete_row(row_pos);
-  }
+  _select_col(col_pos);
+  flush_event(false);
+}
+
+// @brief 列を選択する(通知は行わない)．
+void
+McMatrix::_select_col(
+  SizeType col_pos
+)
+{
+  // _delete_row() は列のリストをつなぎ変えないのでたどりながら削除できる．
+  with_lists([&](const auto& lists) {
+    for ( auto row_pos: lists.col_list(col_pos) ) {
+      _delete_row(row_pos);
+    }
+  });
 
   ASSERT_COND( col_elem_num(col_pos) == 0 );
-  delete_col(col_pos);
+  _delete_col(col_pos);
 }
 
 // @brief 行列を縮約する．
@@ -245,6 +510,8 @@ McMatrix::reduce(
     reduced = true;
   }
 
+  flush_event(false);
+
   return reduced;
 }
 
@@ -264,26 +531,44 @@ McMatrix::reduce_loop(
 }
 
 // @brief 行支配による縮約を行う．
+//
+// 作業リストに入っている行 row1 についてのみ
+// - row1 が支配する行
+// - row1 を支配する行
+// を探す．どちらも row1 と列を共有する行の中から探せばよいので
+// 手間は row1 の近傍の大きさに比例する．
 bool
 McMatrix::row_dominance()
+{
+  return with_lists([&](const auto& lists) {
+    return row_dominance(lists);
+  });
+}
+
+// @brief row_dominance() の本体
+template<class Lists>
+bool
+McMatrix::row_dominance(
+  const Lists& lists
+)
 {
   bool change = false;
 
   // 削除する行番号のリスト
   SizeType del_wpos = 0;
-  for ( auto row_pos1: row_head_list() ) {
-    if ( mRowMark[row_pos1] ) {
-      // すでに削除の印がついていたらスキップ
+  // 訪れた行のリスト
+  vector<SizeType> visited_list;
+  for ( auto row_pos1: mRowWorkList ) {
+    if ( row_deleted(row_pos1) || mRowMark[row_pos1] ) {
+      // 削除された行と削除の印がついた行はスキップ
       continue;
     }
-
-    // row_pos1 の dirty フラグ
-    bool dirty1 = mRowHeadArray[row_pos1].is_dirty();
+    auto num1 = row_elem_num(row_pos1);
 
     // row1 の行に要素を持つ列で要素数が最小のものを求める．
     SizeType min_num = row_size() + 1;
     SizeType min_col = 0;
-    for ( auto col_pos: row_list(row_pos1) ) {
+    for ( auto col_pos: lists.row_list(row_pos1) ) {
       SizeType col_num = col_elem_num(col_pos);
       if ( min_num > col_num ) {
 	min_num = col_num;
@@ -291,13 +576,12 @@ McMatrix::row_dominance()
       }
     }
     // min_col に要素を持つ行のうち row1 に支配されている行を求める．
-    for ( auto row_pos2: col_list(min_col) ) {
+    for ( auto row_pos2: lists.col_list(min_col) ) {
       if ( row_pos2 == row_pos1 ) {
 	// 自分自身は比較しない．
 	continue;
       }
-
-      if ( row_elem_num(row_pos2) < row_elem_num(row_pos1) ) {
+      if ( row_elem_num(row_pos2) < num1 ) {
 	// 要素数が少ない行も比較しない．
 	continue;
       }
@@ -306,14 +590,9 @@ McMatrix::row_dominance()
 	continue;
       }
 
-      // どちらかが dirty でなければチェックする必要はない．
-      if ( !dirty1 && !mRowHeadArray[row_pos2].is_dirty() ) {
-	continue;
-      }
-
       // row1 に含まれる要素をすべて row2 が含んでいる場合
       // row1 が row2 を支配している．
-      if ( check_containment(row_list(row_pos2), row_list(row_pos1)) ) {
+      if ( row_contains(lists, row_pos2, row_pos1) ) {
 	mRowMark[row_pos2] = 1;
 	mDelList[del_wpos] = row_pos2;
 	++ del_wpos;
@@ -324,16 +603,60 @@ McMatrix::row_dominance()
 	}
       }
     }
+
+    // row1 を支配する行を求める．
+    // row1 の要素が減っただけならそのような行は前回の縮約で
+    // 見つかっているはずなので，要素が増えた場合のみ調べる．
+    // そのような行は row1 のいずれかの列に要素を持つ．
+    // mRowMark[row_pos2] == 2 は訪問済みの印
+    if ( !mRowHeadArray[row_pos1].is_grown() ) {
+      continue;
+    }
+    for ( auto col_pos: lists.row_list(row_pos1) ) {
+      for ( auto row_pos2: lists.col_list(col_pos) ) {
+	if ( row_pos2 == row_pos1 || mRowMark[row_pos2] ) {
+	  continue;
+	}
+	if ( mRowHeadArray[row_pos2].is_dirty() ) {
+	  // dirty な行は自身が支配する行を探すのでここでは調べない．
+	  continue;
+	}
+	mRowMark[row_pos2] = 2;
+	visited_list.push_back(row_pos2);
+	if ( row_elem_num(row_pos2) > num1 ) {
+	  // 要素数が多い行は row1 を支配しない．
+	  continue;
+	}
+	if ( row_contains(lists, row_pos1, row_pos2) ) {
+	  mRowMark[row_pos1] = 1;
+	  mDelList[del_wpos] = row_pos1;
+	  ++ del_wpos;
+	  change = true;
+	  if ( mcmatrix_debug > 1 ) {
+	    cout << "Row#" << row_pos1 << " is dominated by Row#"
+		 << row_pos2 << endl;
+	  }
+	  break;
+	}
+      }
+      if ( mRowMark[row_pos1] ) {
+	break;
+      }
+    }
+    for ( auto row_pos2: visited_list ) {
+      if ( mRowMark[row_pos2] == 2 ) {
+	mRowMark[row_pos2] = 0;
+      }
+    }
+    visited_list.clear();
   }
-  // 全ての行の dirty フラグを降ろす．
-  for ( auto row_pos1: row_head_list() ) {
-    mRowHeadArray[row_pos1].set_dirty(false);
-  }
+  // 作業リストの行の dirty フラグを降ろす．
+  clear_row_work();
 
   // 実際に削除する．
   for ( auto i: Range(del_wpos) ) {
     auto row = mDelList[i];
-    delete_row(row);
+    _delete_row(row);
     mRowMark[row] = 0;
   }
 
@@ -343,28 +666,55 @@ McMatrix::row_dominance()
 }
 
 // @brief 列支配による縮約を行う．
+//
+// 作業リストに入っている列 col1 についてのみ
+// - col1 を支配する列
+// - col1 が支配する列
+// を探す．
+// col2 が col1 を支配するのは col2 が col1 の行をすべて含み，
+// かつ col2 のコストが col1 のコスト以下の時である．
 bool
 McMatrix::col_dominance(
   vector<SizeType>& deleted_cols,
   const McColComp& col_comp
 )
+{
+  return with_lists([&](const auto& lists) {
+    return col_dominance(lists, deleted_cols, col_comp);
+  });
+}
+
+// @brief col_dominance() の本体
+template<class Lists>
+bool
+McMatrix::col_dominance(
+  const Lists& lists,
+  vector<SizeType>& deleted_cols,
+  const McColComp& col_comp
+)
 {
   SizeType del_wpos = 0;
-  for ( auto col_pos1: col_head_list() ) {
-    if ( col_elem_num(col_pos1) == 0 ) {
+  // 訪れた列のリスト
+  vector<SizeType> visited_list;
+  for ( auto col_pos1: mColWorkList ) {
+    if ( col_deleted(col_pos1) || mColMark[col_pos1] ) {
+      // 削除された列と削除の印がついた列はスキップ
+      continue;
+    }
+    auto num1 = col_elem_num(col_pos1);
+    if ( num1 == 0 ) {
       // 要素を持たない列は無条件で削除する．
+      mColMark[col_pos1] = 1;
       mDelList[del_wpos] = col_pos1;
       ++ del_wpos;
       continue;
     }
-
-    // col_pos1 の dirty フラグ
-    bool dirty1 = mColHeadArray[col_pos1].is_dirty();
+    auto cost1 = col_cost(col_pos1);
 
     // col1 の列に要素を持つ行で要素数が最小のものを求める．
     SizeType min_num = col_size() + 1;
     SizeType min_row = 0;
-    for ( auto row_pos: col_list(col_pos1) ) {
+    for ( auto row_pos: lists.col_list(col_pos1) ) {
       SizeType row_num = row_elem_num(row_pos);
       if ( min_num > row_num ) {
 	min_num = row_num;
@@ -373,7 +723,7 @@ McMatrix::col_dominance(
     }
 
     // min_row の行に要素を持つ列を対象にして支配関係のチェックを行う．
-    for ( auto col_pos2: row_list(min_row) ) {
+    for ( auto col_pos2: lists.row_list(min_row) ) {
       if ( col_pos2 == col_pos1 ) {
 	// 自分自身は比較しない．
 	continue;
@@ -382,19 +732,18 @@ McMatrix::col_dominance(
 	// 削除済みならスキップ
 	continue;
       }
-      if ( col_elem_num(col_pos2) < col_elem_num(col_pos1) ) {
+      if ( col_elem_num(col_pos2) < num1 ) {
 	// ただし col1 よりも要素数の少ない列は調べる必要はない．
 	continue;
       }
-
-      // どちらかが dirty でなければチェックする必要はない．
-      if ( !dirty1 && !mColHeadArray[col_pos2].is_dirty() ) {
+      if ( col_cost(col_pos2) > cost1 ) {
+	// col1 よりもコストの高い列は col1 を支配しない．
 	continue;
       }
 
       // col1 に含まれる要素を col2 がすべて含んでいる場合
       // col2 は col_head1 を支配している．
-      if ( check_containment(col_list(col_pos2), col_list(col_pos1)) ) {
+      if ( col_contains(lists, col_pos2, col_pos1) ) {
 	if ( col_comp(col_pos1, col_pos2) ) {
 	  // col1 を col2 を置き換えてコストが上がらない場合には col1 を削除できる．
 	  mColMark[col_pos1] = 1;
@@ -408,17 +757,64 @@ McMatrix::col_dominance(
 	}
       }
     }
+    if ( mColMark[col_pos1] ) {
+      continue;
+    }
+
+    // col1 が支配する列を求める．
+    // col1 の要素が減っただけならそのような列は前回の縮約で
+    // 見つかっているはずなので，要素が増えた場合のみ調べる．
+    // そのような列は col1 のいずれかの行に要素を持つ．
+    // mColMark[col_pos2] == 2 は訪問済みの印
+    if ( !mColHeadArray[col_pos1].is_grown() ) {
+      continue;
+    }
+    for ( auto row_pos: lists.col_list(col_pos1) ) {
+      for ( auto col_pos2: lists.row_list(row_pos) ) {
+	if ( col_pos2 == col_pos1 || mColMark[col_pos2] ) {
+	  continue;
+	}
+	if ( mColHeadArray[col_pos2].is_dirty() ) {
+	  // dirty な列は自身を支配する列を探すのでここでは調べない．
+	  continue;
+	}
+	mColMark[col_pos2] = 2;
+	visited_list.push_back(col_pos2);
+	if ( col_elem_num(col_pos2) > num1 ) {
+	  // 要素数が多い列は col1 に支配されない．
+	  continue;
+	}
+	if ( col_cost(col_pos2) < cost1 ) {
+	  // col1 よりもコストの低い列は col1 に支配されない．
+	  continue;
+	}
+	if ( col_contains(lists, col_pos1, col_pos2) &&
+	     col_comp(col_pos2, col_pos1) ) {
+	  mColMark[col_pos2] = 1;
+	  mDelList[del_wpos] = col_pos2;
+	  ++ del_wpos;
+	  if ( mcmatrix_debug > 1 ) {
+	    cout << "Col#" << col_pos2 << " is dominated by Col#"
+		 << col_pos1 << endl;
+	  }
+	}
+      }
+    }
+    for ( auto col_pos2: visited_list ) {
+      if ( mColMark[col_pos2] == 2 ) {
+	mColMark[col_pos2] = 0;
+      }
+    }
+    visited_list.clear();
   }
-  // すべての列の dirty フラグを降ろしておく．p
-  for ( auto col_pos1: col_head_list() ) {
-    mColHeadArray[col_pos1].set_dirty(false);
-  }
+  // 作業リストの列の dirty フラグを降ろす．
+  clear_col_work();
 
   // 実際に削除する．
   deleted_cols.reserve(deleted_cols.size() + del_wpos);
   for ( auto i: Range(del_wpos) ) {
     auto col = mDelList[i];
-    delete_col(col);
+    _delete_col(col);
     deleted_cols.push_back(col);
     mColMark[col] = 0;
   }
@@ -429,15 +825,20 @@ McMatrix::col_dominance(
 }
 
 // @brief 必須列による縮約を行う．
+//
+// 要素数が 1 になりうるのは要素数が変化した行だけなので
+// 行の作業リストのみを調べる．
 bool
 McMatrix::essential_col(
   vector<SizeType>& selected_cols
 )
 {
   SizeType old_size = selected_cols.size();
-  for ( auto row_pos1: row_head_list() ) {
-    if ( row_elem_num(row_pos1) == 1 ) {
-      SizeType col_pos = row_list(row_pos1).front();
+  for ( auto row_pos1: mRowWorkList ) {
+    if ( !row_deleted(row_pos1) && row_elem_num(row_pos1) == 1 ) {
+      SizeType col_pos = with_lists([&](const auto& lists) {
+	return lists.row_list(row_pos1).front();
+      });
       if ( !mColMark[col_pos] ) {
 	mColMark[col_pos] = 1;
 	selected_cols.push_back(col_pos);
@@ -450,7 +851,7 @@ McMatrix::essential_col(
   SizeType size = selected_cols.size();
   for ( auto i: Range(old_size, size) ) {
     SizeType col_pos = selected_cols[i];
-    select_col(col_pos);
+    _select_col(col_pos);
     mColMark[col_pos] = 0;
   }
 
@@ -464,11 +865,42 @@ void
 McMatrix::delete_row(
   SizeType row_pos
 )
+{
+  _delete_row(row_pos);
+  flush_event(false);
+}
+
+// @brief 行を削除する(通知は行わない)．
+void
+McMatrix::_delete_row(
+  SizeType row_pos
+)
 {
   // ヘッダを削除する．
   auto row_head = &mRowHeadArray[row_pos];
   mRowHeadList.exclude(row_head);
   push(row_head);
+  mHash ^= row_key(row_pos);
+  if ( !mObserverList.empty() ) {
+    mRowEventList.push_back(row_pos);
+  }
+
+  if ( mCompact ) {
+    auto& cells = mCellArray;
+    auto dummy = row_dummy_id(row_pos);
+    for ( auto id = cells.row_next(dummy);
+	  id != dummy; id = cells.row_next(id) ) {
+      // id を列方向のリンクから切り離す．
+      auto prev = cells.col_prev(id);
+      auto next = cells.col_next(id);
+      cells.mDownArray[prev] = next;
+      cells.mUpArray[next] = prev;
+      // id の列の要素数を1つ減らす．
+      dec_col_num(cells.col_pos(id));
+      mColBits.reset(cells.col_pos(id), row_pos);
+    }
+    return;
+  }
 
   auto dummy = mRowArray[row_pos];
   for ( auto cell = dummy->row_next();
@@ -481,7 +913,8 @@ McMatrix::delete_row(
     prev->mDownLink = next;
     next->mUpLink = prev;
     // cell の列の要素数を1つ減らす．
-    mColHeadArray[cell->col_pos()].dec_num();
+    dec_col_num(cell->col_pos());
+    mColBits.reset(cell->col_pos(), row_pos);
   }
 }
 
@@ -494,8 +927,34 @@ McMatrix::restore_row(
   // ヘッダを復元する．
   mRowHeadList.restore(row_head);
 
-  // 行の要素を復元する．
+  // 復元した行自身も支配関係のチェックの対象とする．
+  // 他の行に支配されている可能性もあるので grown フラグも立てる．
   SizeType row_pos = row_head->pos();
+  mHash ^= row_key(row_pos);
+  if ( !mObserverList.empty() ) {
+    mRowEventList.push_back(row_pos);
+  }
+  add_row_work(row_pos);
+  row_head->set_grown(true);
+
+  // 行の要素を復元する．
+  if ( mCompact ) {
+    auto& cells = mCellArray;
+    auto dummy = row_dummy_id(row_pos);
+    for ( auto id = cells.row_next(dummy);
+	  id != dummy; id = cells.row_next(id) ) {
+      // id を列方向のリンクに戻す．
+      auto prev = cells.col_prev(id);
+      auto next = cells.col_next(id);
+      cells.mDownArray[prev] = id;
+      cells.mUpArray[next] = id;
+      // id の列の要素数を1つ増やす．
+      inc_col_num(cells.col_pos(id));
+      mColBits.set(cells.col_pos(id), row_pos);
+    }
+    return;
+  }
+
   auto dummy = mRowArray[row_pos];
   for ( auto cell = dummy->row_next();
 	cell != dummy; cell = cell->row_next() ) {
@@ -507,7 +966,8 @@ McMatrix::restore_row(
     prev->mDownLink = cell;
     next->mUpLink = cell;
     // cell の列の要素数を1つ増やす．
-    mColHeadArray[cell->col_pos()].inc_num();
+    inc_col_num(cell->col_pos());
+    mColBits.set(cell->col_pos(), row_pos);
   }
 }
 
@@ -516,11 +976,42 @@ void
 McMatrix::delete_col(
   SizeType col_pos
 )
+{
+  _delete_col(col_pos);
+  flush_event(false);
+}
+
+// @brief 列を削除する(通知は行わない)．
+void
+McMatrix::_delete_col(
+  SizeType col_pos
+)
 {
   // ヘッダを削除する．
   auto col_head = &mColHeadArray[col_pos];
   mColHeadList.exclude(col_head);
   push(col_head);
+  mHash ^= col_key(col_pos);
+  if ( !mObserverList.empty() ) {
+    mColEventList.push_back(col_pos);
+  }
+
+  if ( mCompact ) {
+    auto& cells = mCellArray;
+    auto dummy = col_dummy_id(col_pos);
+    for ( auto id = cells.col_next(dummy);
+	  id != dummy; id = cells.col_next(id) ) {
+      // id を行方向のリンクから切り離す．
+      auto prev = cells.row_prev(id);
+      auto next = cells.row_next(id);
+      cells.mRightArray[prev] = next;
+      cells.mLeftArray[next] = prev;
+      // id の行の要素数を1つ減らす．
+      dec_row_num(cells.row_pos(id));
+      mRowBits.reset(cells.row_pos(id), col_pos);
+    }
+    return;
+  }
 
   auto dummy = mColArray[col_pos];
   for ( auto cell = dummy->col_next();
@@ -533,7 +1024,8 @@ McMatrix::delete_col(
     prev->mRightLink = next;
     next->mLeftLink = prev;
     // cell の行の要素数を1つ減らす．
-    mRowHeadArray[cell->row_pos()].dec_num();
+    dec_row_num(cell->row_pos());
+    mRowBits.reset(cell->row_pos(), col_pos);
   }
 }
 
@@ -546,8 +1038,34 @@ McMatrix::restore_col(
   // ヘッダを復元する．
   mColHeadList.restore(col_head);
 
-  // この列の要素を復元する．
+  // 復元した列自身も支配関係のチェックの対象とする．
+  // 他の列を支配している可能性もあるので grown フラグも立てる．
   SizeType col_pos = col_head->pos();
+  mHash ^= col_key(col_pos);
+  if ( !mObserverList.empty() ) {
+    mColEventList.push_back(col_pos);
+  }
+  add_col_work(col_pos);
+  col_head->set_grown(true);
+
+  // この列の要素を復元する．
+  if ( mCompact ) {
+    auto& cells = mCellArray;
+    auto dummy = col_dummy_id(col_pos);
+    for ( auto id = cells.col_next(dummy);
+	  id != dummy; id = cells.col_next(id) ) {
+      // id を行方向のリンクに戻す．
+      auto prev = cells.row_prev(id);
+      auto next = cells.row_next(id);
+      cells.mRightArray[prev] = id;
+      cells.mLeftArray[next] = id;
+      // id の行の要素数を1つ増やす．
+      inc_row_num(cells.row_pos(id));
+      mRowBits.set(cells.row_pos(id), col_pos);
+    }
+    return;
+  }
+
   auto dummy = mColArray[col_pos];
   for ( auto cell = dummy->col_next();
 	cell != dummy; cell = cell->col_next() ) {
@@ -559,7 +1077,8 @@ McMatrix::restore_col(
     prev->mRightLink = cell;
     next->mLeftLink = cell;
     // cell の行の要素数を1つ増やす．
-    mRowHeadArray[cell->row_pos()].inc_num();
+    inc_row_num(cell->row_pos());
+    mRowBits.set(cell->row_pos(), col_pos);
   }
 }
 
@@ -567,6 +1086,7 @@ McMatrix::restore_col(
 void
 McMatrix::save()
 {
+  mCleanStack.push_back(mRowWorkList.empty() && mColWorkList.empty());
   push(nullptr);
 }
 
@@ -574,9 +1094,12 @@ McMatrix::save()
 void
 McMatrix::restore()
 {
+  bool clean = false;
   while ( !stack_empty() ) {
     McHead* head = pop();
     if ( head == nullptr ) {
+      clean = mCleanStack.back();
+      mCleanStack.pop_back();
       break;
     }
     if ( head->is_row() ) {
@@ -586,6 +1109,65 @@ McMatrix::restore()
       restore_col(head);
     }
   }
+  if ( clean ) {
+    // save() の時点で縮約済みだったので
+    // 復元の際に積まれた作業リストは不要
+    clear_row_work();
+    clear_col_work();
+  }
+  flush_event(true);
+}
+
+// @brief 溜まっている変更を McObserver に通知する．
+void
+McMatrix::notify_event(
+  bool restored
+)
+{
+  // 通知の途中で行列が変更されることはないので
+  // リストは通知がすべて終わってからクリアする．
+  for ( auto observer: mObserverList ) {
+    if ( !mRowEventList.empty() ) {
+      if ( restored ) {
+	observer->rows_restored(mRowEventList);
+      }
+      else {
+	observer->rows_deleted(mRowEventList);
+      }
+    }
+    if ( !mColEventList.empty() ) {
+      if ( restored ) {
+	observer->cols_restored(mColEventList);
+      }
+      else {
+	observer->cols_deleted(mColEventList);
+      }
+    }
+  }
+  mRowEventList.clear();
+  mColEventList.clear();
+}
+
+// @brief 行の作業リストをクリアする．
+void
+McMatrix::clear_row_work()
+{
+  for ( auto row_pos: mRowWorkList ) {
+    mRowHeadArray[row_pos].set_dirty(false);
+    mRowHeadArray[row_pos].set_grown(false);
+  }
+  mRowWorkList.clear();
+}
+
+// @brief 列の作業リストをクリアする．
+void
+McMatrix::clear_col_work()
+{
+  for ( auto col_pos: mColWorkList ) {
+    mColHeadArray[col_pos].set_dirty(false);
+    mColHeadArray[col_pos].set_grown(false);
+  }
+  mColWorkList.clear();
 }
 
 // @brief サイズを変更する．
@@ -595,7 +1177,8 @@ McMatrix::resize(
   SizeType col_size
 )
 {
-  mCellList.clear();
+  mCellSlabList.clear();
+  mCellArray.clear();
   mRowHeadArray.clear();
   mRowArray.clear();
   mRowMark.clear();
@@ -603,29 +1186,38 @@ McMatrix::resize(
   mColArray.clear();
   mCostArray.clear();
   mColMark.clear();
+  // 内容が変わるので McObserver の登録は外す．
+  mObserverList.clear();
+  mRowEventList.clear();
+  mColEventList.clear();
 
   mRowSize = row_size;
   mColSize = col_size;
 
   mRowHeadArray.resize(mRowSize);
-  mRowArray.resize(mRowSize, nullptr);
   mRowMark.resize(mRowSize, 0);
   for ( auto row_pos: Range(mRowSize) ) {
     mRowHeadArray[row_pos].init(row_pos, false);
-    mRowArray[row_pos] = alloc_cell(row_pos, -1);
   }
 
   mColHeadArray.resize(mColSize);
-  mColArray.resize(mColSize, nullptr);
   mCostArray.resize(mColSize, 1);
   mColMark.resize(mColSize, 0);
   for ( auto col_pos: Range(mColSize) ) {
     mColHeadArray[col_pos].init(col_pos, true);
-    mColArray[col_pos] = alloc_cell(-1, col_pos);
   }
 
+  init_dummies(0);
+  init_bits();
+
   mDelStack.resize(row_size + col_size);
   mStackTop = 0;
+  mCleanStack.clear();
+  mHash = 0;
+  mRowWorkList.clear();
+  mRowWorkList.reserve(mRowSize);
+  mColWorkList.clear();
+  mColWorkList.reserve(mColSize);
 
   auto rc_max = std::max(mRowSize, mColSize);
   mDelList.resize(rc_max);
@@ -642,17 +1234,177 @@ McMatrix::copy(
   ASSERT_COND( row_size() == src.row_size() );
   ASSERT_COND( col_size() == src.col_size() );
 
-  for ( auto row_pos: Range_<SizeType>(row_size()) ) {
-    for ( auto col_pos: row_list(row_pos) ) {
-      insert_elem(ElemType{row_pos, col_pos});
+  src.with_lists([&](const auto& lists) {
+    for ( auto row_pos: Range_<SizeType>(row_size()) ) {
+      for ( auto col_pos: lists.row_list(row_pos) ) {
+	insert_elem(ElemType{row_pos, col_pos});
+      }
     }
-  }
+  });
 
   for ( auto col_pos: Range(mColSize) ) {
     mCostArray[col_pos] = src.mCostArray[col_pos];
   }
 }
 
+// @brief 行の包含関係を調べる．
+bool
+McMatrix::row_contains(
+  SizeType row_pos1,
+  SizeType row_pos2
+) const
+{
+  return with_lists([&](const auto& lists) {
+    return row_contains(lists, row_pos1, row_pos2);
+  });
+}
+
+// @brief row_contains() の本体
+template<class Lists>
+bool
+McMatrix::row_contains(
+  const Lists& lists,
+  SizeType row_pos1,
+  SizeType row_pos2
+) const
+{
+  if ( (row_sig(lists, row_pos2) & ~row_sig(lists, row_pos1)) != 0 ) {
+    // row2 にあって row1 にない要素がある．
+    return false;
+  }
+  if ( mRowBits.is_valid() ) {
+    if ( row_elem_num(row_pos2) < mRowBits.word_num() ) {
+      // row2 の要素が少ない時は row1 のビットを個別に調べる．
+      for ( auto col_pos: lists.row_list(row_pos2) ) {
+	if ( !mRowBits.test(row_pos1, col_pos) ) {
+	  return false;
+	}
+      }
+      return true;
+    }
+    return mRowBits.contains(row_pos1, row_pos2);
+  }
+  return check_containment(lists.row_list(row_pos1), lists.row_list(row_pos2));
+}
+
+// @brief 列の包含関係を調べる．
+bool
+McMatrix::col_contains(
+  SizeType col_pos1,
+  SizeType col_pos2
+) const
+{
+  return with_lists([&](const auto& lists) {
+    return col_contains(lists, col_pos1, col_pos2);
+  });
+}
+
+// @brief col_contains() の本体
+template<class Lists>
+bool
+McMatrix::col_contains(
+  const Lists& lists,
+  SizeType col_pos1,
+  SizeType col_pos2
+) const
+{
+  if ( (col_sig(lists, col_pos2) & ~col_sig(lists, col_pos1)) != 0 ) {
+    // col2 にあって col1 にない要素がある．
+    return false;
+  }
+  if ( mColBits.is_valid() ) {
+    if ( col_elem_num(col_pos2) < mColBits.word_num() ) {
+      // col2 の要素が少ない時は col1 のビットを個別に調べる．
+      for ( auto row_pos: lists.col_list(col_pos2) ) {
+	if ( !mColBits.test(col_pos1, row_pos) ) {
+	  return false;
+	}
+      }
+      return true;
+    }
+    return mColBits.contains(col_pos1, col_pos2);
+  }
+  return check_containment(lists.col_list(col_pos1), lists.col_list(col_pos2));
+}
+
+BEGIN_NONAMESPACE
+
+// 位置番号をハッシュしてシグネチャのビットを求める．
+inline
+std::uint64_t
+sig_bit(
+  SizeType pos
+)
+{
+  auto h = static_cast<std::uint64_t>(pos) * 0x9E3779B97F4A7C15ULL;
+  return std::uint64_t{1} << (h >> 58);
+}
+
+END_NONAMESPACE
+
+// @brief 行のシグネチャを返す．
+template<class Lists>
+std::uint64_t
+McMatrix::row_sig(
+  const Lists& lists,
+  SizeType row_pos
+) const
+{
+  auto sig = mRowSigArray[row_pos];
+  if ( sig == 0 ) {
+    // 無効化されているので計算し直す．
+    // 空の行のシグネチャは 0 のままで構わない．
+    for ( auto col_pos: lists.row_list(row_pos) ) {
+      sig |= sig_bit(col_pos);
+    }
+    mRowSigArray[row_pos] = sig;
+  }
+  return sig;
+}
+
+// @brief 列のシグネチャを返す．
+template<class Lists>
+std::uint64_t
+McMatrix::col_sig(
+  const Lists& lists,
+  SizeType col_pos
+) const
+{
+  auto sig = mColSigArray[col_pos];
+  if ( sig == 0 ) {
+    // 無効化されているので計算し直す．
+    // 空の列のシグネチャは 0 のままで構わない．
+    for ( auto row_pos: lists.col_list(col_pos) ) {
+      sig |= sig_bit(row_pos);
+    }
+    mColSigArray[col_pos] = sig;
+  }
+  return sig;
+}
+
+// @brief シグネチャとビットベクタを初期化する．
+void
+McMatrix::init_bits()
+{
+  mRowSigArray.clear();
+  mRowSigArray.resize(mRowSize, 0);
+  mColSigArray.clear();
+  mColSigArray.resize(mColSize, 0);
+
+  // ビットベクタは行方向，列方向それぞれ 32MB までとする．
+  const SizeType word_limit = 4 * 1024 * 1024;
+  auto row_words = mRowSize * ((mColSize + 63) / 64);
+  auto col_words = mColSize * ((mRowSize + 63) / 64);
+  if ( row_words <= word_limit && col_words <= word_limit ) {
+    mRowBits.init(mRowSize, mColSize);
+    mColBits.init(mColSize, mRowSize);
+  }
+  else {
+    mRowBits.clear();
+    mColBits.clear();
+  }
+}
+
 // @brief 列集合のコストを返す．
 SizeType
 McMatrix::cost(
@@ -676,11 +1428,13 @@ McMatrix::verify(
   vector<bool> row_mark(row_size(), false);
 
   // col_list の列でカバーされた行に印をつける．
-  for ( auto col_pos: colpos_list ) {
-    for ( auto row_pos: col_list(col_pos) ) {
-      row_mark[row_pos] = true;
+  with_lists([&](const auto& lists) {
+    for ( auto col_pos: colpos_list ) {
+      for ( auto row_pos: lists.col_list(col_pos) ) {
+	row_mark[row_pos] = true;
+      }
     }
-  }
+  });
 
   // 印の付いていない行があったらエラー
   for ( auto row_pos: Range(row_size()) ) {
@@ -708,6 +1462,36 @@ McMatrix::check_mark_sanity()
   return true;
 }
 
+// @brief ダミーセルを作る．
+void
+McMatrix::init_dummies(
+  SizeType elem_num
+)
+{
+  if ( mCompact ) {
+    // ダミー要素は行，列の順に先頭に置く．
+    mCellArray.reserve(mRowSize + mColSize + elem_num);
+    for ( auto row_pos: Range(mRowSize) ) {
+      mCellArray.new_cell(row_pos, -1);
+    }
+    for ( auto col_pos: Range(mColSize) ) {
+      mCellArray.new_cell(-1, col_pos);
+    }
+    return;
+  }
+
+  // ダミーセルと要素のセルをまとめて確保する．
+  new_slab(mRowSize + mColSize + elem_num);
+  mRowArray.resize(mRowSize, nullptr);
+  for ( auto row_pos: Range(mRowSize) ) {
+    mRowArray[row_pos] = alloc_cell(row_pos, -1);
+  }
+  mColArray.resize(mColSize, nullptr);
+  for ( auto col_pos: Range(mColSize) ) {
+    mColArray[col_pos] = alloc_cell(-1, col_pos);
+  }
+}
+
 // @brief セルの生成
 McCell*
 McMatrix::alloc_cell(
@@ -715,9 +1499,32 @@ McMatrix::alloc_cell(
   SizeType col_pos
 )
 {
-  auto cell = new McCell(row_pos,  col_pos);
-  mCellList.push_back(std::unique_ptr<McCell>{cell});
-  return cell;
+  if ( mCellSlabList.empty() ||
+       mCellSlabList.back().size() == mCellSlabList.back().capacity() ) {
+    // 後から追加される要素用のスラブは直前のスラブと同じ大きさにする．
+    // ただし最低でも 1024 とする．
+    SizeType size = 1024;
+    if ( !mCellSlabList.empty() ) {
+      size = std::max(size, mCellSlabList.back().capacity());
+    }
+    new_slab(size);
+  }
+  auto& slab = mCellSlabList.back();
+  slab.emplace_back(row_pos, col_pos);
+  return &slab.back();
+}
+
+// @brief セル用の領域(スラブ)を追加する．
+void
+McMatrix::new_slab(
+  SizeType size
+)
+{
+  if ( size == 0 ) {
+    return;
+  }
+  mCellSlabList.push_back(vector<McCell>{});
+  mCellSlabList.back().reserve(size);
 }
 
 // @brief 内容を出力する．
@@ -731,13 +1538,15 @@ McMatrix::print(
       s << "Col#" << col_pos << ": " << col_cost(col_pos) << endl;
     }
   }
-  for ( auto row_pos: Range(row_size()) ) {
-    s << "Row#" << row_pos << ":";
-    for ( auto col_pos: row_list(row_pos) ) {
-      s << " " << col_pos;
+  with_lists([&](const auto& lists) {
+    for ( auto row_pos: Range(row_size()) ) {
+      s << "Row#" << row_pos << ":";
+      for ( auto col_pos: lists.row_list(row_pos) ) {
+	s << " " << col_pos;
+      }
+      s << endl;
     }
-    s << endl;
-  }
+  });
 }
 
 END_NAMESPACE_YM_MINCOV
@@ -0,0 +1,123 @@
+
+/// @file McObserver.cc
+/// @brief McObserver の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "mincov/McObserver.h"
+#include "mincov/McMatrix.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+// クラス McObserver
+//////////////////////////////////////////////////////////////////////
+
+// @brief デストラクタ
+McObserver::~McObserver()
+{
+  detach();
+}
+
+// @brief 行列に登録する．
+void
+McObserver::attach(
+  const McMatrix& matrix
+)
+{
+  if ( mMatrix == &matrix ) {
+    return;
+  }
+  detach();
+  matrix.add_observer(this);
+}
+
+// @brief 登録を解除する．
+void
+McObserver::detach()
+{
+  if ( mMatrix != nullptr ) {
+    mMatrix->remove_observer(this);
+  }
+}
+
+// @brief 行が削除された時に呼ばれる関数
+void
+McObserver::rows_deleted(
+  const vector<SizeType>& row_list
+)
+{
+}
+
+// @brief 列が削除された時に呼ばれる関数
+void
+McObserver::cols_deleted(
+  const vector<SizeType>& col_list
+)
+{
+}
+
+// @brief 行が復元された時に呼ばれる関数
+void
+McObserver::rows_restored(
+  const vector<SizeType>& row_list
+)
+{
+}
+
+// @brief 列が復元された時に呼ばれる関数
+void
+McObserver::cols_restored(
+  const vector<SizeType>& col_list
+)
+{
+}
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス McObserverList
+//////////////////////////////////////////////////////////////////////
+
+// @brief 登録する．
+void
+McObserverList::add(
+  const McMatrix* matrix,
+  McObserver* observer
+)
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  ASSERT_COND( observer->mMatrix == nullptr );
+  mList.push_back(observer);
+  observer->mMatrix = matrix;
+}
+
+// @brief 登録を解除する．
+void
+McObserverList::remove(
+  McObserver* observer
+)
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  auto p = std::find(mList.begin(), mList.end(), observer);
+  if ( p != mList.end() ) {
+    *p = mList.back();
+    mList.pop_back();
+    observer->mMatrix = nullptr;
+  }
+}
+
+// @brief すべての登録を解除する．
+void
+McObserverList::clear()
+{
+  std::lock_guard<std::mutex> lock{mMutex};
+  for ( auto observer: mList ) {
+    observer->mMatrix = nullptr;
+  }
+  mList.clear();
+}
+
+END_NAMESPACE_YM_MINCOV
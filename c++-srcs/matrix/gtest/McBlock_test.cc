@@ -0,0 +1,75 @@
+
+/// @file McBlock_test.cc
+/// @brief McBlock_test の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "mincov/McBlock.h"
+#include "mincov/McMatrix.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+TEST(McBlockTest, partition1)
+{
+  // 行 0, 2 と列 0, 3 からなるブロックと
+  // 行 1, 3, 4 と列 1, 2, 4 からなるブロックに分かれる．
+  SizeType nr = 5;
+  vector<MinCov::ElemType> elem_list{
+    {0, 0}, {0, 3},
+    {1, 1},
+    {2, 3},
+    {3, 1}, {3, 2},
+    {4, 2}, {4, 4}
+  };
+  vector<SizeType> cost_array{1, 2, 3, 4, 5};
+  McMatrix mtx{nr, cost_array, elem_list};
+
+  auto block_list = McBlock::partition(mtx);
+  ASSERT_EQ( 2, block_list.size() );
+  auto& block0 = block_list[0];
+  EXPECT_EQ( (vector<SizeType>{0, 2}), block0.row_list() );
+  EXPECT_EQ( (vector<SizeType>{0, 3}), block0.col_list() );
+  auto& block1 = block_list[1];
+  EXPECT_EQ( (vector<SizeType>{1, 3, 4}), block1.row_list() );
+  EXPECT_EQ( (vector<SizeType>{1, 2, 4}), block1.col_list() );
+
+  // ブロックの行列は番号が振り直される．
+  auto bmtx = block1.new_matrix(mtx);
+  EXPECT_EQ( 3, bmtx->row_size() );
+  EXPECT_EQ( 3, bmtx->col_size() );
+  EXPECT_EQ( 2, bmtx->col_cost(0) );
+  EXPECT_EQ( 3, bmtx->col_cost(1) );
+  EXPECT_EQ( 5, bmtx->col_cost(2) );
+  EXPECT_EQ( 1, bmtx->row_elem_num(0) );
+  EXPECT_EQ( 2, bmtx->row_elem_num(1) );
+  EXPECT_EQ( 2, bmtx->row_elem_num(2) );
+  EXPECT_EQ( 2, bmtx->col_elem_num(1) );
+
+  // 列 3 を選ぶと行 0, 2 が消えてブロックは1つになる．
+  mtx.select_col(3);
+  block_list = McBlock::partition(mtx);
+  ASSERT_EQ( 1, block_list.size() );
+  EXPECT_EQ( (vector<SizeType>{1, 3, 4}), block_list[0].row_list() );
+}
+
+TEST(McBlockTest, partition2)
+{
+  // 長い鎖状の行列でも1つのブロックになる．
+  SizeType n = 100000;
+  vector<MinCov::ElemType> elem_list;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    elem_list.push_back({i, i});
+    elem_list.push_back({i, i + 1});
+  }
+  McMatrix mtx{n, n + 1, elem_list};
+  auto block_list = McBlock::partition(mtx);
+  ASSERT_EQ( 1, block_list.size() );
+  EXPECT_EQ( n, block_list[0].row_num() );
+  EXPECT_EQ( n + 1, block_list[0].col_num() );
+}
+
+END_NAMESPACE_YM_MINCOV
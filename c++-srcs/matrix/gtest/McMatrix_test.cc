@@ -8,10 +8,16 @@
 
 #include <gtest/gtest.h>
 #include "mincov/McMatrix.h"
+#include <random>
+#include <type_traits>
 
 
 BEGIN_NAMESPACE_YM_MINCOV
 
+// セルは行列ごとのスラブ上にあるので単純なコピーはできない．
+static_assert( !std::is_copy_constructible_v<McMatrix> );
+static_assert( !std::is_copy_assignable_v<McMatrix> );
+
 TEST(McMatrixTest, constr1)
 {
   SizeType nr = 3;
@@ -137,4 +143,561 @@ TEST(McMatrixTest, constr3)
   }
 }
 
+TEST(McMatrixTest, insert_elem1)
+{
+  // 最初のスラブに収まらない数の要素を後から追加する．
+  SizeType nr = 100;
+  SizeType nc = 50;
+  auto mtx = McMatrix(nr, nc);
+  for ( SizeType row_pos = 0; row_pos < nr; ++ row_pos ) {
+    for ( SizeType col_pos = 0; col_pos < nc; ++ col_pos ) {
+      if ( (row_pos + col_pos) % 3 == 0 ) {
+	mtx.insert_elem({row_pos, col_pos});
+      }
+    }
+  }
+
+  EXPECT_EQ( nr, mtx.active_row_num() );
+  EXPECT_EQ( nc, mtx.active_col_num() );
+  for ( SizeType row_pos = 0; row_pos < nr; ++ row_pos ) {
+    vector<SizeType> exp_list;
+    for ( SizeType col_pos = 0; col_pos < nc; ++ col_pos ) {
+      if ( (row_pos + col_pos) % 3 == 0 ) {
+	exp_list.push_back(col_pos);
+      }
+    }
+    vector<SizeType> col_list;
+    for ( auto col_pos: mtx.row_list(row_pos) ) {
+      col_list.push_back(col_pos);
+    }
+    EXPECT_EQ( exp_list, col_list );
+    EXPECT_EQ( exp_list.size(), mtx.row_elem_num(row_pos) );
+  }
+  for ( SizeType col_pos = 0; col_pos < nc; ++ col_pos ) {
+    vector<SizeType> exp_list;
+    for ( SizeType row_pos = 0; row_pos < nr; ++ row_pos ) {
+      if ( (row_pos + col_pos) % 3 == 0 ) {
+	exp_list.push_back(row_pos);
+      }
+    }
+    vector<SizeType> row_list;
+    for ( auto row_pos: mtx.col_list(col_pos) ) {
+      row_list.push_back(row_pos);
+    }
+    EXPECT_EQ( exp_list, row_list );
+    EXPECT_EQ( exp_list.size(), mtx.col_elem_num(col_pos) );
+  }
+}
+
+TEST(McMatrixTest, constr4)
+{
+  // 順不同で重複を含む要素のリスト
+  SizeType nr = 4;
+  SizeType nc = 5;
+  auto elem_list = vector<MinCov::ElemType>{
+    {3, 4}, {0, 2}, {2, 1}, {0, 0}, {3, 0},
+    {0, 2}, {2, 4}, {1, 3}, {2, 1}, {3, 2}
+  };
+  auto mtx = McMatrix(nr, nc, elem_list);
+
+  EXPECT_EQ( nr, mtx.active_row_num() );
+  EXPECT_EQ( nc, mtx.active_col_num() );
+
+  auto exp_row_list = vector<vector<SizeType>>{
+    {0, 2}, {3}, {1, 4}, {0, 2, 4}
+  };
+  for ( SizeType row_pos = 0; row_pos < nr; ++ row_pos ) {
+    vector<SizeType> col_list;
+    for ( auto col_pos: mtx.row_list(row_pos) ) {
+      col_list.push_back(col_pos);
+    }
+    EXPECT_EQ( exp_row_list[row_pos], col_list );
+    EXPECT_EQ( exp_row_list[row_pos].size(), mtx.row_elem_num(row_pos) );
+  }
+
+  auto exp_col_list = vector<vector<SizeType>>{
+    {0, 3}, {2}, {0, 3}, {1}, {2, 3}
+  };
+  for ( SizeType col_pos = 0; col_pos < nc; ++ col_pos ) {
+    vector<SizeType> row_list;
+    for ( auto row_pos: mtx.col_list(col_pos) ) {
+      row_list.push_back(row_pos);
+    }
+    EXPECT_EQ( exp_col_list[col_pos], row_list );
+    EXPECT_EQ( exp_col_list[col_pos].size(), mtx.col_elem_num(col_pos) );
+  }
+}
+
+BEGIN_NONAMESPACE
+
+// 2つの行列の内容が等しいか調べる．
+void
+check_equal(
+  const McMatrix& mtx1,
+  const McMatrix& mtx2
+)
+{
+  ASSERT_EQ( mtx1.row_size(), mtx2.row_size() );
+  ASSERT_EQ( mtx1.col_size(), mtx2.col_size() );
+  EXPECT_TRUE( mtx1.row_head_list() == mtx2.row_head_list() );
+  EXPECT_TRUE( mtx1.col_head_list() == mtx2.col_head_list() );
+  for ( SizeType row_pos = 0; row_pos < mtx1.row_size(); ++ row_pos ) {
+    EXPECT_EQ( mtx1.row_elems(row_pos), mtx2.row_elems(row_pos) );
+    EXPECT_EQ( mtx1.row_elem_num(row_pos), mtx2.row_elem_num(row_pos) );
+  }
+  for ( SizeType col_pos = 0; col_pos < mtx1.col_size(); ++ col_pos ) {
+    EXPECT_EQ( mtx1.col_elems(col_pos), mtx2.col_elems(col_pos) );
+    EXPECT_EQ( mtx1.col_elem_num(col_pos), mtx2.col_elem_num(col_pos) );
+  }
+}
+
+END_NONAMESPACE
+
+TEST(McMatrixTest, compact1)
+{
+  // 通常モードとコンパクトモードで同じ操作を行い，結果を比較する．
+  SizeType nr = 30;
+  SizeType nc = 20;
+  std::mt19937 randgen(1);
+  std::uniform_int_distribution<SizeType> rd_row(0, nr - 1);
+  std::uniform_int_distribution<SizeType> rd_col(0, nc - 1);
+  vector<MinCov::ElemType> elem_list;
+  for ( SizeType i = 0; i < 150; ++ i ) {
+    elem_list.push_back({rd_row(randgen), rd_col(randgen)});
+  }
+  auto mtx1 = McMatrix(nr, nc, elem_list);
+  auto mtx2 = McMatrix(nr, nc, elem_list, true);
+  EXPECT_FALSE( mtx1.is_compact() );
+  EXPECT_TRUE( mtx2.is_compact() );
+  check_equal(mtx1, mtx2);
+
+  // 後から要素を追加する．
+  for ( SizeType i = 0; i < 30; ++ i ) {
+    MinCov::ElemType elem{rd_row(randgen), rd_col(randgen)};
+    mtx1.insert_elem(elem);
+    mtx2.insert_elem(elem);
+    elem_list.push_back(elem);
+  }
+  check_equal(mtx1, mtx2);
+
+  // 削除と復元
+  for ( SizeType k = 0; k < 10; ++ k ) {
+    mtx1.save();
+    mtx2.save();
+    for ( SizeType i = 0; i < 5; ++ i ) {
+      auto col_pos = rd_col(randgen);
+      if ( !mtx1.col_deleted(col_pos) ) {
+	mtx1.select_col(col_pos);
+	mtx2.select_col(col_pos);
+      }
+      auto row_pos = rd_row(randgen);
+      if ( !mtx1.row_deleted(row_pos) ) {
+	mtx1.delete_row(row_pos);
+	mtx2.delete_row(row_pos);
+      }
+      check_equal(mtx1, mtx2);
+    }
+    mtx1.restore();
+    mtx2.restore();
+    check_equal(mtx1, mtx2);
+  }
+  check_equal(mtx1, McMatrix(nr, nc, elem_list));
+  check_equal(mtx2, McMatrix(nr, nc, elem_list, true));
+}
+
+BEGIN_NONAMESPACE
+
+// a が b の要素をすべて含んでいたら true を返す．
+template<class List>
+bool
+contains(
+  const List& a,
+  const List& b
+)
+{
+  for ( auto pos_b: b ) {
+    bool found = false;
+    for ( auto pos_a: a ) {
+      if ( pos_a == pos_b ) {
+	found = true;
+	break;
+      }
+    }
+    if ( !found ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// 行列がこれ以上縮約できないことを総当たりで確かめる．
+void
+check_reduced(
+  const McMatrix& mtx
+)
+{
+  for ( auto row_pos1: mtx.row_head_list() ) {
+    EXPECT_LT( 1, mtx.row_elem_num(row_pos1) );
+    for ( auto row_pos2: mtx.row_head_list() ) {
+      if ( row_pos1 != row_pos2 ) {
+	EXPECT_FALSE( contains(mtx.row_elems(row_pos2), mtx.row_elems(row_pos1)) )
+	  << "Row#" << row_pos2 << " is dominated by Row#" << row_pos1;
+      }
+    }
+  }
+  for ( auto col_pos1: mtx.col_head_list() ) {
+    EXPECT_LT( 0, mtx.col_elem_num(col_pos1) );
+    for ( auto col_pos2: mtx.col_head_list() ) {
+      if ( col_pos1 != col_pos2 &&
+	   mtx.col_cost(col_pos2) <= mtx.col_cost(col_pos1) ) {
+	EXPECT_FALSE( contains(mtx.col_elems(col_pos2), mtx.col_elems(col_pos1)) )
+	  << "Col#" << col_pos1 << " is dominated by Col#" << col_pos2;
+      }
+    }
+  }
+}
+
+END_NONAMESPACE
+
+TEST(McMatrixTest, reduce1)
+{
+  // 作業リストを用いた縮約の結果が不動点になっていることを確かめる．
+  SizeType nr = 40;
+  SizeType nc = 30;
+  std::mt19937 randgen(2);
+  std::uniform_int_distribution<SizeType> rd_row(0, nr - 1);
+  std::uniform_int_distribution<SizeType> rd_col(0, nc - 1);
+  std::uniform_int_distribution<SizeType> rd_cost(1, 3);
+  for ( bool compact: {false, true} ) {
+    vector<MinCov::ElemType> elem_list;
+    for ( SizeType i = 0; i < 200; ++ i ) {
+      elem_list.push_back({rd_row(randgen), rd_col(randgen)});
+    }
+    vector<SizeType> cost_array(nc);
+    for ( auto& cost: cost_array ) {
+      cost = rd_cost(randgen);
+    }
+    auto mtx = McMatrix(nr, cost_array, elem_list, compact);
+    vector<SizeType> selected_cols;
+    vector<SizeType> deleted_cols;
+    mtx.reduce_loop(selected_cols, deleted_cols);
+    check_reduced(mtx);
+
+    // 分枝限定法と同様に列の選択/削除と復元を繰り返す．
+    for ( SizeType k = 0; k < 20 && mtx.active_col_num() > 0; ++ k ) {
+      vector<SizeType> col_list;
+      for ( auto col_pos: mtx.col_head_list() ) {
+	col_list.push_back(col_pos);
+      }
+      auto col_pos = col_list[randgen() % col_list.size()];
+      mtx.save();
+      mtx.select_col(col_pos);
+      mtx.reduce_loop(selected_cols, deleted_cols);
+      check_reduced(mtx);
+      mtx.restore();
+      check_reduced(mtx);
+      mtx.delete_col(col_pos);
+      mtx.reduce_loop(selected_cols, deleted_cols);
+      check_reduced(mtx);
+    }
+
+    // 要素を追加して row1 が row2 を支配するようにする．
+    for ( SizeType k = 0; k < 10 && mtx.active_row_num() > 1; ++ k ) {
+      vector<SizeType> row_list;
+      for ( auto row_pos: mtx.row_head_list() ) {
+	row_list.push_back(row_pos);
+      }
+      std::shuffle(row_list.begin(), row_list.end(), randgen);
+      auto row_pos1 = row_list[0];
+      auto row_pos2 = row_list[1];
+      for ( auto col_pos: mtx.row_elems(row_pos1) ) {
+	mtx.insert_elem({row_pos2, col_pos});
+      }
+      mtx.reduce_loop(selected_cols, deleted_cols);
+      check_reduced(mtx);
+    }
+
+    // 要素を追加して col2 が col1 を支配するようにする．
+    for ( SizeType k = 0; k < 10 && mtx.active_col_num() > 1; ++ k ) {
+      vector<SizeType> col_list;
+      for ( auto col_pos: mtx.col_head_list() ) {
+	col_list.push_back(col_pos);
+      }
+      std::shuffle(col_list.begin(), col_list.end(), randgen);
+      auto col_pos1 = col_list[0];
+      auto col_pos2 = col_list[1];
+      if ( mtx.col_cost(col_pos1) < mtx.col_cost(col_pos2) ) {
+	std::swap(col_pos1, col_pos2);
+      }
+      for ( auto row_pos: mtx.col_elems(col_pos1) ) {
+	mtx.insert_elem({row_pos, col_pos2});
+      }
+      mtx.reduce_loop(selected_cols, deleted_cols);
+      check_reduced(mtx);
+    }
+  }
+}
+
+TEST(McMatrixTest, reduce2)
+{
+  // 行が増えたことで他の行に支配されるようになる場合
+  // 列 0, 1, 2, 3 の間には支配関係がないようにしておく．
+  SizeType nr = 6;
+  SizeType nc = 4;
+  vector<MinCov::ElemType> elem_list{
+    {0, 0}, {0, 1},
+    {1, 2}, {1, 3},
+    {2, 0}, {2, 2},
+    {3, 1}, {3, 3},
+    {4, 0}, {4, 3},
+    {5, 1}, {5, 2}
+  };
+  for ( bool compact: {false, true} ) {
+    auto mtx = McMatrix(nr, nc, elem_list, compact);
+    vector<SizeType> selected_cols;
+    vector<SizeType> deleted_cols;
+    mtx.reduce_loop(selected_cols, deleted_cols);
+    EXPECT_EQ( nr, mtx.active_row_num() );
+    EXPECT_EQ( nc, mtx.active_col_num() );
+
+    // 行 1 に列 0, 1 を加えると行 1 は他のすべての行に支配される．
+    mtx.insert_elem({1, 0});
+    mtx.insert_elem({1, 1});
+    mtx.reduce_loop(selected_cols, deleted_cols);
+    EXPECT_TRUE( mtx.row_deleted(1) );
+    check_reduced(mtx);
+  }
+}
+
+TEST(McMatrixTest, contains1)
+{
+  // row_contains()/col_contains() の結果が
+  // リストをたどる check_containment() と一致することを確かめる．
+  // 1行が複数ワードになるように列数を多めにしておく．
+  SizeType nr = 80;
+  SizeType nc = 300;
+  std::mt19937 randgen(3);
+  std::uniform_int_distribution<SizeType> rd_col(0, nc - 1);
+  vector<MinCov::ElemType> elem_list;
+  for ( SizeType row_pos = 0; row_pos < nr; ++ row_pos ) {
+    // 行ごとに要素数を変える．
+    SizeType n = (row_pos % 4 == 0) ? 2 : 150;
+    for ( SizeType i = 0; i < n; ++ i ) {
+      elem_list.push_back({row_pos, rd_col(randgen)});
+    }
+  }
+  // 包含関係が成り立つ行を作っておく．
+  for ( SizeType row_pos = 0; row_pos + 1 < nr; row_pos += 8 ) {
+    for ( auto& elem: vector<MinCov::ElemType>(elem_list) ) {
+      if ( elem.row_pos == row_pos ) {
+	elem_list.push_back({row_pos + 1, elem.col_pos});
+      }
+    }
+  }
+  for ( bool compact: {false, true} ) {
+    auto mtx = McMatrix(nr, nc, elem_list, compact);
+    EXPECT_TRUE( mtx.use_bits() );
+    for ( SizeType k = 0; k < 3; ++ k ) {
+      mtx.with_lists([&](const auto& lists) {
+	for ( auto row_pos1: mtx.row_head_list() ) {
+	  for ( auto row_pos2: mtx.row_head_list() ) {
+	    EXPECT_EQ( check_containment(lists.row_list(row_pos1), lists.row_list(row_pos2)),
+		       mtx.row_contains(row_pos1, row_pos2) );
+	  }
+	}
+	for ( auto col_pos1: mtx.col_head_list() ) {
+	  for ( auto col_pos2: mtx.col_head_list() ) {
+	    EXPECT_EQ( check_containment(lists.col_list(col_pos1), lists.col_list(col_pos2)),
+		       mtx.col_contains(col_pos1, col_pos2) );
+	  }
+	}
+      });
+      // 列を削除して同じことを繰り返す．
+      mtx.save();
+      for ( SizeType i = 0; i < 100; ++ i ) {
+	auto col_pos = rd_col(randgen);
+	if ( !mtx.col_deleted(col_pos) ) {
+	  mtx.delete_col(col_pos);
+	}
+      }
+    }
+  }
+}
+
+TEST(McMatrixTest, hash1)
+{
+  // hash() がアクティブな行と列の集合だけで決まることを確かめる．
+  SizeType nr = 5;
+  SizeType nc = 4;
+  vector<MinCov::ElemType> elem_list{
+    {0, 0}, {0, 1},
+    {1, 1}, {1, 2},
+    {2, 2}, {2, 3},
+    {3, 0}, {3, 3},
+    {4, 1}, {4, 3}
+  };
+  for ( bool compact: {false, true} ) {
+    auto mtx = McMatrix(nr, nc, elem_list, compact);
+    // insert_elem() で作っても同じ値になる．
+    auto mtx2 = McMatrix(nr, nc, vector<MinCov::ElemType>{}, compact);
+    for ( auto& elem: elem_list ) {
+      mtx2.insert_elem(elem);
+    }
+    auto hash0 = mtx.hash();
+    EXPECT_EQ( hash0, mtx2.hash() );
+
+    mtx.save();
+    mtx.delete_row(0);
+    auto hash1 = mtx.hash();
+    EXPECT_NE( hash0, hash1 );
+    mtx.save();
+    mtx.delete_col(2);
+    mtx.delete_row(4);
+    auto hash2 = mtx.hash();
+    EXPECT_NE( hash1, hash2 );
+    mtx.restore();
+    EXPECT_EQ( hash1, mtx.hash() );
+    mtx.restore();
+    EXPECT_EQ( hash0, mtx.hash() );
+
+    // 削除の順番によらない．
+    mtx.save();
+    mtx.delete_row(4);
+    mtx.delete_col(2);
+    mtx.delete_row(0);
+    EXPECT_EQ( hash2, mtx.hash() );
+    mtx.restore();
+    EXPECT_EQ( hash0, mtx.hash() );
+  }
+}
+
+// 通知の内容を記録する McObserver
+class TestObserver :
+  public McObserver
+{
+public:
+
+  void
+  rows_deleted(
+    const vector<SizeType>& row_list
+  ) override
+  {
+    mLog.push_back({'r', '-', sorted(row_list)});
+  }
+
+  void
+  cols_deleted(
+    const vector<SizeType>& col_list
+  ) override
+  {
+    mLog.push_back({'c', '-', sorted(col_list)});
+  }
+
+  void
+  rows_restored(
+    const vector<SizeType>& row_list
+  ) override
+  {
+    mLog.push_back({'r', '+', sorted(row_list)});
+  }
+
+  void
+  cols_restored(
+    const vector<SizeType>& col_list
+  ) override
+  {
+    mLog.push_back({'c', '+', sorted(col_list)});
+  }
+
+  static
+  vector<SizeType>
+  sorted(
+    const vector<SizeType>& src
+  )
+  {
+    auto dst = src;
+    std::sort(dst.begin(), dst.end());
+    return dst;
+  }
+
+  struct Event
+  {
+    char kind;
+    char op;
+    vector<SizeType> list;
+  };
+
+  vector<Event> mLog;
+
+};
+
+TEST(McMatrixTest, observer1)
+{
+  SizeType nr = 5;
+  SizeType nc = 4;
+  vector<MinCov::ElemType> elem_list{
+    {0, 0}, {0, 1},
+    {1, 1}, {1, 2},
+    {2, 2}, {2, 3},
+    {3, 0}, {3, 3},
+    {4, 1}, {4, 3}
+  };
+  for ( bool compact: {false, true} ) {
+    auto mtx = McMatrix(nr, nc, elem_list, compact);
+    TestObserver obs;
+    obs.attach(mtx);
+    EXPECT_EQ( &mtx, obs.observed_matrix() );
+
+    // select_col() は行の削除と列の削除をまとめて通知する．
+    mtx.save();
+    mtx.select_col(1);
+    ASSERT_EQ( 2, obs.mLog.size() );
+    EXPECT_EQ( 'r', obs.mLog[0].kind );
+    EXPECT_EQ( '-', obs.mLog[0].op );
+    EXPECT_EQ( (vector<SizeType>{0, 1, 4}), obs.mLog[0].list );
+    EXPECT_EQ( 'c', obs.mLog[1].kind );
+    EXPECT_EQ( '-', obs.mLog[1].op );
+    EXPECT_EQ( (vector<SizeType>{1}), obs.mLog[1].list );
+    obs.mLog.clear();
+
+    mtx.delete_col(3);
+    ASSERT_EQ( 1, obs.mLog.size() );
+    EXPECT_EQ( 'c', obs.mLog[0].kind );
+    EXPECT_EQ( (vector<SizeType>{3}), obs.mLog[0].list );
+    obs.mLog.clear();
+
+    // restore() は復元した行と列をまとめて通知する．
+    mtx.restore();
+    ASSERT_EQ( 2, obs.mLog.size() );
+    EXPECT_EQ( 'r', obs.mLog[0].kind );
+    EXPECT_EQ( '+', obs.mLog[0].op );
+    EXPECT_EQ( (vector<SizeType>{0, 1, 4}), obs.mLog[0].list );
+    EXPECT_EQ( 'c', obs.mLog[1].kind );
+    EXPECT_EQ( '+', obs.mLog[1].op );
+    EXPECT_EQ( (vector<SizeType>{1, 3}), obs.mLog[1].list );
+    obs.mLog.clear();
+
+    // 登録を外すと通知されない．
+    obs.detach();
+    EXPECT_EQ( nullptr, obs.observed_matrix() );
+    mtx.save();
+    mtx.delete_row(2);
+    mtx.restore();
+    EXPECT_TRUE( obs.mLog.empty() );
+
+    // 要素を追加すると登録が外れる．
+    obs.attach(mtx);
+    mtx.insert_elem({2, 0});
+    EXPECT_EQ( nullptr, obs.observed_matrix() );
+
+    // 行列が先に破棄されても登録が外れる．
+    {
+      auto mtx2 = McMatrix(nr, nc, elem_list, compact);
+      obs.attach(mtx2);
+      EXPECT_EQ( &mtx2, obs.observed_matrix() );
+    }
+    EXPECT_EQ( nullptr, obs.observed_matrix() );
+  }
+}
+
 END_NAMESPACE_YM_MINCOV
@@ -0,0 +1,191 @@
+
+/// @file containment_bench.cc
+/// @brief 包含関係のチェックの速度を比較するプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "mincov/McMatrix.h"
+#include "ym/Timer.h"
+#include <random>
+#include <libgen.h>
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+void
+usage(
+  char* arg0
+)
+{
+  cerr << "Usage: " << basename(arg0)
+       << " [--compact] <row_size> <col_size> <elem_per_row> [<seed>]" << endl;
+}
+
+// 行支配のチェックと同じ候補の組を作る．
+// row1 の要素のうちの1つを含み，row1 以上の要素数を持つ行を row2 とする．
+vector<pair<SizeType, SizeType>>
+row_pairs(
+  const McMatrix& matrix,
+  std::mt19937& randgen
+)
+{
+  vector<pair<SizeType, SizeType>> pair_list;
+  for ( auto row_pos1: matrix.row_head_list() ) {
+    auto col_list = matrix.row_elems(row_pos1);
+    auto col_pos = col_list[randgen() % col_list.size()];
+    for ( auto row_pos2: matrix.col_elems(col_pos) ) {
+      if ( row_pos2 != row_pos1 &&
+	   matrix.row_elem_num(row_pos2) >= matrix.row_elem_num(row_pos1) ) {
+	pair_list.push_back({row_pos2, row_pos1});
+      }
+    }
+  }
+  return pair_list;
+}
+
+// 列支配のチェックと同じ候補の組を作る．
+vector<pair<SizeType, SizeType>>
+col_pairs(
+  const McMatrix& matrix,
+  std::mt19937& randgen
+)
+{
+  vector<pair<SizeType, SizeType>> pair_list;
+  for ( auto col_pos1: matrix.col_head_list() ) {
+    auto row_list = matrix.col_elems(col_pos1);
+    auto row_pos = row_list[randgen() % row_list.size()];
+    for ( auto col_pos2: matrix.row_elems(row_pos) ) {
+      if ( col_pos2 != col_pos1 &&
+	   matrix.col_elem_num(col_pos2) >= matrix.col_elem_num(col_pos1) ) {
+	pair_list.push_back({col_pos2, col_pos1});
+      }
+    }
+  }
+  return pair_list;
+}
+
+int
+containment_bench(
+  int argc,
+  char** argv
+)
+{
+  bool compact = false;
+  int base = 1;
+  for ( ; base < argc; ++ base ) {
+    auto opt = string{argv[base]};
+    if ( opt == "--compact" ) {
+      compact = true;
+    }
+    else {
+      break;
+    }
+  }
+  if ( argc - base != 3 && argc - base != 4 ) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  SizeType row_size = std::stoul(argv[base + 0]);
+  SizeType col_size = std::stoul(argv[base + 1]);
+  SizeType elem_per_row = std::stoul(argv[base + 2]);
+  SizeType seed = 0;
+  if ( argc - base == 4 ) {
+    seed = std::stoul(argv[base + 3]);
+  }
+
+  std::mt19937 randgen(seed);
+  std::uniform_int_distribution<SizeType> rd_col(0, col_size - 1);
+  vector<MinCov::ElemType> elem_list;
+  elem_list.reserve(row_size * elem_per_row);
+  for ( SizeType row_pos = 0; row_pos < row_size; ++ row_pos ) {
+    for ( SizeType i = 0; i < elem_per_row; ++ i ) {
+      elem_list.push_back(MinCov::ElemType{row_pos, rd_col(randgen)});
+    }
+  }
+  McMatrix matrix{row_size, col_size, elem_list, compact};
+
+  cout << row_size << " x " << col_size << ", "
+       << elem_list.size() << " elements"
+       << (compact ? " (compact)" : "")
+       << (matrix.use_bits() ? " (bitset)" : " (signature only)") << endl;
+
+  Timer timer;
+  for ( int dir = 0; dir < 2; ++ dir ) {
+    auto pair_list = dir == 0 ? row_pairs(matrix, randgen) : col_pairs(matrix, randgen);
+
+    // リストをたどる版
+    SizeType n1 = 0;
+    timer.reset();
+    timer.start();
+    matrix.with_lists([&](const auto& lists) {
+      for ( auto& p: pair_list ) {
+	bool stat = dir == 0 ?
+	  check_containment(lists.row_list(p.first), lists.row_list(p.second)) :
+	  check_containment(lists.col_list(p.first), lists.col_list(p.second));
+	if ( stat ) {
+	  ++ n1;
+	}
+      }
+    });
+    timer.stop();
+    auto t1 = timer.get_time();
+
+    // シグネチャ + ビットベクタ版
+    // 1回目はシグネチャの計算を含むので2回測る．
+    SizeType n2 = 0;
+    double t2[2];
+    for ( int k = 0; k < 2; ++ k ) {
+      n2 = 0;
+      timer.reset();
+      timer.start();
+      for ( auto& p: pair_list ) {
+	bool stat = dir == 0 ?
+	  matrix.row_contains(p.first, p.second) :
+	  matrix.col_contains(p.first, p.second);
+	if ( stat ) {
+	  ++ n2;
+	}
+      }
+      timer.stop();
+      t2[k] = timer.get_time();
+    }
+
+    cout << (dir == 0 ? " row" : " col") << ": "
+	 << pair_list.size() << " pairs, "
+	 << n1 << " contained" << endl
+	 << "   linked list:  " << t1 << "(ms)" << endl
+	 << "   accelerated:  " << t2[0] << "(ms) / " << t2[1] << "(ms)" << endl;
+    if ( n1 != n2 ) {
+      cout << "Error: results differ (" << n2 << ")" << endl;
+      return 1;
+    }
+  }
+
+  // 縮約全体の時間
+  timer.reset();
+  timer.start();
+  vector<SizeType> selected_cols;
+  vector<SizeType> deleted_cols;
+  matrix.reduce_loop(selected_cols, deleted_cols);
+  timer.stop();
+  cout << " reduce_loop: " << timer.get_time() << "(ms), "
+       << matrix.active_row_num() << " x " << matrix.active_col_num()
+       << " remains" << endl;
+
+  return 0;
+}
+
+END_NAMESPACE_YM_MINCOV
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return nsYm::nsMincov::containment_bench(argc, argv);
+}
@@ -0,0 +1,143 @@
+
+/// @file mcmatrix_bench.cc
+/// @brief McMatrix の構築/破棄時間を計測するプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "mincov/McMatrix.h"
+#include "ym/Timer.h"
+#include <random>
+#include <libgen.h>
+#include <fstream>
+#include <unistd.h>
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+// 現在の RSS を MB 単位で返す．
+// /proc/self/statm が読めない環境では 0 を返す．
+SizeType
+current_rss()
+{
+  std::ifstream s{"/proc/self/statm"};
+  SizeType size = 0;
+  SizeType resident = 0;
+  if ( s >> size >> resident ) {
+    return resident * sysconf(_SC_PAGESIZE) / (1024 * 1024);
+  }
+  return 0;
+}
+
+void
+usage(
+  char* arg0
+)
+{
+  cerr << "Usage: " << basename(arg0)
+       << " [--shuffle] [--compact] <row_size> <col_size> <elem_per_row> [<seed>]" << endl;
+}
+
+int
+mcmatrix_bench(
+  int argc,
+  char** argv
+)
+{
+  bool shuffle = false;
+  bool compact = false;
+  int base = 1;
+  for ( ; base < argc; ++ base ) {
+    auto opt = string{argv[base]};
+    if ( opt == "--shuffle" ) {
+      shuffle = true;
+    }
+    else if ( opt == "--compact" ) {
+      compact = true;
+    }
+    else {
+      break;
+    }
+  }
+  if ( argc - base != 3 && argc - base != 4 ) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  SizeType row_size = std::stoul(argv[base + 0]);
+  SizeType col_size = std::stoul(argv[base + 1]);
+  SizeType elem_per_row = std::stoul(argv[base + 2]);
+  SizeType seed = 0;
+  if ( argc - base == 4 ) {
+    seed = std::stoul(argv[base + 3]);
+  }
+
+  // 行ごとに elem_per_row 個の要素をランダムに作る．
+  std::mt19937 randgen(seed);
+  std::uniform_int_distribution<SizeType> rd_col(0, col_size - 1);
+  vector<MinCov::ElemType> elem_list;
+  elem_list.reserve(row_size * elem_per_row);
+  for ( SizeType row_pos = 0; row_pos < row_size; ++ row_pos ) {
+    vector<SizeType> col_list(elem_per_row);
+    for ( auto& col_pos: col_list ) {
+      col_pos = rd_col(randgen);
+    }
+    std::sort(col_list.begin(), col_list.end());
+    for ( auto col_pos: col_list ) {
+      elem_list.push_back(MinCov::ElemType{row_pos, col_pos});
+    }
+  }
+  if ( shuffle ) {
+    std::shuffle(elem_list.begin(), elem_list.end(), randgen);
+  }
+
+  cout << row_size << " x " << col_size << ", "
+       << elem_list.size() << " elements"
+       << (shuffle ? " (shuffled)" : "")
+       << (compact ? " (compact)" : "") << endl;
+
+  auto rss0 = current_rss();
+  Timer timer;
+  timer.start();
+  auto matrix = new McMatrix{row_size, col_size, elem_list, compact};
+  timer.stop();
+  cout << " construction: " << timer.get_time() / 1000.0 << "(s)" << endl;
+  cout << " matrix RSS: " << current_rss() - rss0 << "(MB)" << endl;
+
+  // 全ての列の削除/復元を行う．
+  timer.reset();
+  timer.start();
+  vector<SizeType> col_list;
+  col_list.reserve(matrix->active_col_num());
+  for ( auto col_pos: matrix->col_head_list() ) {
+    col_list.push_back(col_pos);
+  }
+  matrix->save();
+  for ( auto col_pos: col_list ) {
+    matrix->delete_col(col_pos);
+  }
+  matrix->restore();
+  timer.stop();
+  cout << " delete/restore all columns: " << timer.get_time() / 1000.0 << "(s)" << endl;
+
+  timer.reset();
+  timer.start();
+  delete matrix;
+  timer.stop();
+  cout << " teardown: " << timer.get_time() / 1000.0 << "(s)" << endl;
+
+  return 0;
+}
+
+END_NAMESPACE_YM_MINCOV
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return nsYm::nsMincov::mcmatrix_bench(argc, argv);
+}
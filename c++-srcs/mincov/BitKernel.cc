@@ -0,0 +1,661 @@
+
+/// @file BitKernel.cc
+/// @brief BitKernel の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "BitKernel.h"
+#include "mincov/McMatrix.h"
+#include <unordered_map>
+#include <cmath>
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+// クラス BitKernel::Engine
+//////////////////////////////////////////////////////////////////////
+
+// W ワードのビットマスクで行集合を表して探索を行うクラス
+// W = 1 と W = 2 だけを用いる．
+template<SizeType W>
+class BitKernel::Engine
+{
+public:
+
+  // 行集合を表すビットマスク
+  struct Mask
+  {
+    std::uint64_t mWord[W];
+
+    bool
+    operator==(
+      const Mask& right
+    ) const
+    {
+      for ( SizeType i = 0; i < W; ++ i ) {
+	if ( mWord[i] != right.mWord[i] ) {
+	  return false;
+	}
+      }
+      return true;
+    }
+  };
+
+  // Mask のハッシュ関数
+  struct MaskHash
+  {
+    SizeType
+    operator()(
+      const Mask& mask
+    ) const
+    {
+      std::uint64_t h = 0;
+      for ( SizeType i = 0; i < W; ++ i ) {
+	// splitmix64 の混ぜ方を用いる．
+	std::uint64_t x = h + mask.mWord[i] + 0x9e3779b97f4a7c15ULL;
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+	h = x ^ (x >> 31);
+      }
+      return h;
+    }
+  };
+
+  // 表の要素
+  struct Entry
+  {
+    // exact が true の時は最小コスト，false の時は下界
+    int value;
+
+    // exact が true の時に選んだ列(内部番号)
+    SizeType col;
+
+    // 最小コストが求まっている時 true
+    bool exact;
+  };
+
+  // コンストラクタ
+  Engine(
+    const McMatrix& matrix,
+    SizeType table_size,
+    const std::function<bool()>& stop
+  ) : mTableSize{table_size},
+      mStop{stop}
+  {
+    // 被覆する列の少ない行から順にビットを割り当てる．
+    // 先頭のビットの行で分岐すれば被覆する列の最も少ない行で分岐できる．
+    vector<SizeType> row_list;
+    row_list.reserve(matrix.active_row_num());
+    for ( auto row_pos: matrix.row_head_list() ) {
+      row_list.push_back(row_pos);
+    }
+    std::stable_sort(row_list.begin(), row_list.end(),
+		     [&](SizeType a, SizeType b) {
+		       return matrix.row_elem_num(a) < matrix.row_elem_num(b);
+		     });
+    SizeType nr = row_list.size();
+    ASSERT_COND( nr <= W * 64 );
+    vector<SizeType> row_map(matrix.row_size(), 0);
+    for ( SizeType i = 0; i < nr; ++ i ) {
+      row_map[row_list[i]] = i;
+    }
+
+    // 列ごとのマスクを作る．
+    matrix.with_lists([&](const auto& lists) {
+      for ( auto col_pos: matrix.col_head_list() ) {
+	Mask mask = empty_mask();
+	for ( auto row_pos: lists.col_list(col_pos) ) {
+	  set_bit(mask, row_map[row_pos]);
+	}
+	if ( !any(mask) ) {
+	  continue;
+	}
+	mColMask.push_back(mask);
+	mColCost.push_back(matrix.col_cost(col_pos));
+	mColPos.push_back(col_pos);
+      }
+    });
+    SizeType nc = mColMask.size();
+
+    // 行ごとの列のリストはコストの昇順，被覆する行数の降順に並べる．
+    mRowCols.resize(nr);
+    mRowMinCost.resize(nr, INT_MAX);
+    mRowNbr.resize(nr, empty_mask());
+    for ( SizeType j = 0; j < nc; ++ j ) {
+      auto& mask = mColMask[j];
+      for ( SizeType i = 0; i < nr; ++ i ) {
+	if ( test_bit(mask, i) ) {
+	  mRowCols[i].push_back(j);
+	  mRowMinCost[i] = std::min(mRowMinCost[i], mColCost[j]);
+	  or_assign(mRowNbr[i], mask);
+	}
+      }
+    }
+    for ( auto& cols: mRowCols ) {
+      if ( cols.empty() ) {
+	// 被覆できない行がある．
+	mInfeasible = true;
+      }
+      std::sort(cols.begin(), cols.end(),
+		[&](SizeType a, SizeType b) {
+		  if ( mColCost[a] != mColCost[b] ) {
+		    return mColCost[a] < mColCost[b];
+		  }
+		  return popcount(mColMask[a]) > popcount(mColMask[b]);
+		});
+    }
+
+    mFull = empty_mask();
+    for ( SizeType i = 0; i < nr; ++ i ) {
+      set_bit(mFull, i);
+    }
+  }
+
+  // budget 未満の最小被覆を求める．
+  // @return 見つかったら true を返す．
+  bool
+  solve(
+    int budget,
+    int& cost,
+    vector<SizeType>& solution
+  )
+  {
+    if ( mInfeasible ) {
+      return false;
+    }
+    SizeType col;
+    auto value = search(mFull, budget, col);
+    if ( mAborted || value == INT_MAX ) {
+      return false;
+    }
+    // 表をたどって列を復元する．
+    // 表が一杯で記録されていない部分問題は予算を絞って解き直す．
+    cost = value;
+    solution.clear();
+    auto U = mFull;
+    int rest = value;
+    for ( ; ; ) {
+      solution.push_back(mColPos[col]);
+      rest -= mColCost[col];
+      andnot_assign(U, mColMask[col]);
+      if ( !any(U) ) {
+	break;
+      }
+      auto p = mTable.find(U);
+      if ( p != mTable.end() && p->second.exact ) {
+	col = p->second.col;
+      }
+      else {
+	auto value1 = search(U, rest + 1, col);
+	if ( mAborted ) {
+	  return false;
+	}
+	ASSERT_COND( value1 == rest );
+      }
+    }
+    ASSERT_COND( rest == 0 );
+    return true;
+  }
+
+  // 打ち切られた時 true を返す．
+  bool
+  is_aborted() const
+  {
+    return mAborted;
+  }
+
+  // 探索したノード数を返す．
+  SizeType
+  node_num() const
+  {
+    return mNodeNum;
+  }
+
+  // 表を引いて探索を省略した回数を返す．
+  SizeType
+  hit_num() const
+  {
+    return mHitNum;
+  }
+
+
+private:
+
+  // U を被覆する budget 未満の最小コストを求める．
+  // @return 見つからなかったら INT_MAX を返す．
+  //
+  // 見つかった時は best_col に選んだ列を入れる．
+  int
+  search(
+    const Mask& U,
+    int budget,
+    SizeType& best_col
+  )
+  {
+    if ( budget <= 0 ) {
+      return INT_MAX;
+    }
+    ++ mNodeNum;
+    if ( (mNodeNum & 1023) == 0 && mStop() ) {
+      mAborted = true;
+    }
+    if ( mAborted ) {
+      return INT_MAX;
+    }
+
+    auto p = mTable.find(U);
+    if ( p != mTable.end() ) {
+      auto& entry = p->second;
+      if ( entry.exact ) {
+	++ mHitNum;
+	if ( entry.value < budget ) {
+	  best_col = entry.col;
+	  return entry.value;
+	}
+	return INT_MAX;
+      }
+      if ( entry.value >= budget ) {
+	++ mHitNum;
+	return INT_MAX;
+      }
+    }
+
+    auto lb = lower_bound(U);
+    if ( lb >= budget ) {
+      record_lb(U, lb);
+      return INT_MAX;
+    }
+
+    // 先頭の行を被覆する列で分岐する．
+    auto& cols = mRowCols[first_bit(U)];
+    SizeType n = cols.size();
+    int best = INT_MAX;
+    for ( SizeType k = 0; k < n; ++ k ) {
+      auto j = cols[k];
+      int c = mColCost[j];
+      int b = std::min(budget, best) - c;
+      if ( b <= 0 ) {
+	// コストの昇順に並んでいるので以降も同様
+	break;
+      }
+      auto r = and_mask(U, mColMask[j]);
+      if ( is_dominated(U, r, cols, k) ) {
+	continue;
+      }
+      auto U1 = andnot_mask(U, mColMask[j]);
+      int value;
+      if ( !any(U1) ) {
+	value = 0;
+      }
+      else {
+	SizeType dummy;
+	value = search(U1, b, dummy);
+	if ( mAborted ) {
+	  return INT_MAX;
+	}
+      }
+      if ( value != INT_MAX ) {
+	best = value + c;
+	best_col = j;
+      }
+    }
+
+    if ( best != INT_MAX ) {
+      record_exact(U, best, best_col);
+      return best;
+    }
+    record_lb(U, budget);
+    return INT_MAX;
+  }
+
+  // U の下界を求める．
+  int
+  lower_bound(
+    const Mask& U
+  ) const
+  {
+    // 列を共有しない行の集合の最小コストの和
+    int lb1 = 0;
+    auto avail = U;
+    while ( any(avail) ) {
+      auto i = first_bit(avail);
+      lb1 += mRowMinCost[i];
+      andnot_assign(avail, mRowNbr[i]);
+    }
+
+    // 各行をその行を被覆する列で按分したコストの和
+    double lb2 = 0.0;
+    for ( SizeType w = 0; w < W; ++ w ) {
+      for ( auto bits = U.mWord[w]; bits; bits &= bits - 1 ) {
+	SizeType i = w * 64 + __builtin_ctzll(bits);
+	double min_val = static_cast<double>(INT_MAX);
+	for ( auto j: mRowCols[i] ) {
+	  double val = static_cast<double>(mColCost[j]) /
+	    popcount(and_mask(U, mColMask[j]));
+	  min_val = std::min(min_val, val);
+	}
+	lb2 += min_val;
+      }
+    }
+    int lb2i = static_cast<int>(std::ceil(lb2 - 1e-9));
+
+    return std::max(lb1, lb2i);
+  }
+
+  // cols[k] の列が U の中で他の列に支配されている時 true を返す．
+  //
+  // r は cols[k] の列が被覆する U の行の集合
+  // コストが等しくて被覆する行も等しい時は前にあるものを残す．
+  bool
+  is_dominated(
+    const Mask& U,
+    const Mask& r,
+    const vector<SizeType>& cols,
+    SizeType k
+  ) const
+  {
+    int c = mColCost[cols[k]];
+    SizeType n = cols.size();
+    for ( SizeType k1 = 0; k1 < n; ++ k1 ) {
+      if ( k1 == k ) {
+	continue;
+      }
+      auto j1 = cols[k1];
+      int c1 = mColCost[j1];
+      if ( c1 > c ) {
+	break;
+      }
+      auto r1 = and_mask(U, mColMask[j1]);
+      if ( !is_subset(r, r1) ) {
+	continue;
+      }
+      if ( c1 < c || !(r == r1) || k1 < k ) {
+	return true;
+      }
+    }
+    return false;
+  }
+
+  // 最小コストを記録する．
+  void
+  record_exact(
+    const Mask& U,
+    int value,
+    SizeType col
+  )
+  {
+    auto p = mTable.find(U);
+    if ( p != mTable.end() ) {
+      p->second = Entry{value, col, true};
+    }
+    else if ( mTable.size() < mTableSize ) {
+      mTable.emplace(U, Entry{value, col, true});
+    }
+  }
+
+  // 下界を記録する．
+  void
+  record_lb(
+    const Mask& U,
+    int value
+  )
+  {
+    auto p = mTable.find(U);
+    if ( p != mTable.end() ) {
+      if ( p->second.value < value ) {
+	p->second.value = value;
+      }
+    }
+    else if ( mTable.size() < mTableSize ) {
+      mTable.emplace(U, Entry{value, 0, false});
+    }
+  }
+
+  static
+  Mask
+  empty_mask()
+  {
+    Mask mask;
+    for ( SizeType i = 0; i < W; ++ i ) {
+      mask.mWord[i] = 0;
+    }
+    return mask;
+  }
+
+  static
+  void
+  set_bit(
+    Mask& mask,
+    SizeType i
+  )
+  {
+    mask.mWord[i / 64] |= static_cast<std::uint64_t>(1) << (i % 64);
+  }
+
+  static
+  bool
+  test_bit(
+    const Mask& mask,
+    SizeType i
+  )
+  {
+    return (mask.mWord[i / 64] >> (i % 64)) & 1;
+  }
+
+  static
+  bool
+  any(
+    const Mask& mask
+  )
+  {
+    for ( SizeType i = 0; i < W; ++ i ) {
+      if ( mask.mWord[i] ) {
+	return true;
+      }
+    }
+    return false;
+  }
+
+  // 空でないマスクの先頭のビット位置を返す．
+  static
+  SizeType
+  first_bit(
+    const Mask& mask
+  )
+  {
+    for ( SizeType i = 0; i < W; ++ i ) {
+      if ( mask.mWord[i] ) {
+	return i * 64 + __builtin_ctzll(mask.mWord[i]);
+      }
+    }
+    ASSERT_NOT_REACHED;
+    return 0;
+  }
+
+  static
+  int
+  popcount(
+    const Mask& mask
+  )
+  {
+    int n = 0;
+    for ( SizeType i = 0; i < W; ++ i ) {
+      n += __builtin_popcountll(mask.mWord[i]);
+    }
+    return n;
+  }
+
+  static
+  Mask
+  and_mask(
+    const Mask& a,
+    const Mask& b
+  )
+  {
+    Mask mask;
+    for ( SizeType i = 0; i < W; ++ i ) {
+      mask.mWord[i] = a.mWord[i] & b.mWord[i];
+    }
+    return mask;
+  }
+
+  static
+  Mask
+  andnot_mask(
+    const Mask& a,
+    const Mask& b
+  )
+  {
+    Mask mask;
+    for ( SizeType i = 0; i < W; ++ i ) {
+      mask.mWord[i] = a.mWord[i] & ~b.mWord[i];
+    }
+    return mask;
+  }
+
+  static
+  void
+  andnot_assign(
+    Mask& a,
+    const Mask& b
+  )
+  {
+    for ( SizeType i = 0; i < W; ++ i ) {
+      a.mWord[i] &= ~b.mWord[i];
+    }
+  }
+
+  static
+  void
+  or_assign(
+    Mask& a,
+    const Mask& b
+  )
+  {
+    for ( SizeType i = 0; i < W; ++ i ) {
+      a.mWord[i] |= b.mWord[i];
+    }
+  }
+
+  // a が b に含まれる時 true を返す．
+  static
+  bool
+  is_subset(
+    const Mask& a,
+    const Mask& b
+  )
+  {
+    for ( SizeType i = 0; i < W; ++ i ) {
+      if ( a.mWord[i] & ~b.mWord[i] ) {
+	return false;
+      }
+    }
+    return true;
+  }
+
+
+private:
+
+  // 表の最大要素数
+  SizeType mTableSize;
+
+  // 打ち切りを判定する関数
+  const std::function<bool()>& mStop;
+
+  // 列ごとのマスク
+  vector<Mask> mColMask;
+
+  // 列ごとのコスト
+  vector<int> mColCost;
+
+  // 列ごとの元の列番号
+  vector<SizeType> mColPos;
+
+  // 行ごとの被覆する列のリスト
+  vector<vector<SizeType>> mRowCols;
+
+  // 行ごとの被覆する列の最小コスト
+  vector<int> mRowMinCost;
+
+  // 行ごとの列を共有する行のマスク(自身も含む)
+  vector<Mask> mRowNbr;
+
+  // すべての行のマスク
+  Mask mFull;
+
+  // 部分問題の結果の表
+  std::unordered_map<Mask, Entry, MaskHash> mTable;
+
+  // 探索したノード数
+  SizeType mNodeNum{0};
+
+  // 表を引いて探索を省略した回数
+  SizeType mHitNum{0};
+
+  // 被覆できない行がある時 true
+  bool mInfeasible{false};
+
+  // 打ち切られた時 true
+  bool mAborted{false};
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス BitKernel
+//////////////////////////////////////////////////////////////////////
+
+// @brief 現在の行列の最小被覆を求める．
+bool
+BitKernel::solve(
+  const McMatrix& matrix,
+  int budget,
+  const std::function<bool()>& stop,
+  int& cost,
+  vector<SizeType>& solution
+)
+{
+  ASSERT_COND( matrix.active_row_num() <= MAX_ROWS );
+
+  ++ mCallNum;
+  bool found;
+  if ( matrix.active_row_num() <= 64 ) {
+    Engine<1> engine{matrix, mTableSize, stop};
+    found = engine.solve(budget, cost, solution);
+    mAborted = engine.is_aborted();
+    mNodeNum += engine.node_num();
+    mHitNum += engine.hit_num();
+  }
+  else {
+    Engine<2> engine{matrix, mTableSize, stop};
+    found = engine.solve(budget, cost, solution);
+    mAborted = engine.is_aborted();
+    mNodeNum += engine.node_num();
+    mHitNum += engine.hit_num();
+  }
+  if ( found ) {
+    ++ mSolvedNum;
+  }
+  if ( mAborted ) {
+    ++ mAbortNum;
+  }
+  return found;
+}
+
+// @brief 統計情報を出力する．
+void
+BitKernel::print_stats(
+  ostream& s
+) const
+{
+  s << "BitKernel: " << mCallNum << " calls, "
+    << mSolvedNum << " solved, "
+    << mAbortNum << " aborted, "
+    << mNodeNum << " nodes, "
+    << mHitNum << " table hits" << endl;
+}
+
+END_NAMESPACE_YM_MINCOV
@@ -0,0 +1,130 @@
+#ifndef BITKERNEL_H
+#define BITKERNEL_H
+
+/// @file BitKernel.h
+/// @brief BitKernel のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "mincov/mincov_nsdef.h"
+#include <functional>
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+/// @class BitKernel BitKernel.h "BitKernel.h"
+/// @brief 行数の少ない行列の厳密解を求めるクラス
+///
+/// アクティブな行を高々 MAX_ROWS 個のビットで表し，
+/// 列を被覆する行のビットマスクで表して分枝限定法を行う．
+/// McMatrix の縮約や save()/restore() を行わないので，
+/// 分枝限定法の末端の小さな部分問題を速く解くことができる．
+///
+/// * 未被覆の行の集合をビットマスク U で表し，
+///   U を被覆する最小コストを再帰的に求める．
+/// * 被覆する列の最も少ない行で分岐する．
+/// * 下界は以下の大きい方を用いる．
+///   - 各行について「その行を被覆する列のコスト / U の中で被覆する行数」
+///     の最小値を足したもの(LbCS と同じもの)
+///   - 列を共有しない行の集合の各行の最小コストの和
+/// * U ごとに結果を表に記録しておき，同じ U が現れたら再利用する．
+///   - 最小コストが求まった時はその値と選んだ列を記録する．
+///   - 予算内の解がなかった時はその予算を下界として記録する．
+//////////////////////////////////////////////////////////////////////
+class BitKernel
+{
+public:
+
+  /// @brief 扱える最大の行数
+  static constexpr SizeType MAX_ROWS = 128;
+
+  /// @brief コンストラクタ
+  BitKernel(
+    SizeType table_size = 65536 ///< [in] 結果を記録する表の最大要素数
+  ) : mTableSize{table_size}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~BitKernel() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 現在の行列の最小被覆を求める．
+  /// @retval true budget 未満のコストの解が見つかった．
+  /// @retval false budget 未満の解はないか，探索が打ち切られた．
+  ///
+  /// matrix のアクティブな行数は MAX_ROWS 以下でなければならない．
+  /// 解が見つかった時は cost と solution に最小のコストと列のリストが入る．
+  /// stop は一定の間隔で呼ばれ，true を返したら探索を打ち切る．
+  /// 打ち切られたかどうかは is_aborted() で調べる．
+  bool
+  solve(
+    const McMatrix& matrix,            ///< [in] 対象の行列
+    int budget,                        ///< [in] コストの上限(これ未満の解を探す)
+    const std::function<bool()>& stop, ///< [in] 打ち切りを判定する関数
+    int& cost,                         ///< [out] 解のコスト
+    vector<SizeType>& solution         ///< [out] 選ばれた列のリスト
+  );
+
+  /// @brief 直前の solve() が打ち切られた時 true を返す．
+  bool
+  is_aborted() const
+  {
+    return mAborted;
+  }
+
+  /// @brief 統計情報を出力する．
+  void
+  print_stats(
+    ostream& s ///< [in] 出力先のストリーム
+  ) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる型
+  //////////////////////////////////////////////////////////////////////
+
+  template<SizeType W>
+  class Engine;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 結果を記録する表の最大要素数
+  SizeType mTableSize;
+
+  // 直前の solve() が打ち切られた時 true
+  bool mAborted{false};
+
+  // solve() を呼んだ回数
+  SizeType mCallNum{0};
+
+  // 解が見つかった回数
+  SizeType mSolvedNum{0};
+
+  // 打ち切られた回数
+  SizeType mAbortNum{0};
+
+  // 探索したノード数の合計
+  SizeType mNodeNum{0};
+
+  // 表を引いて探索を省略した回数の合計
+  SizeType mHitNum{0};
+
+};
+
+END_NAMESPACE_YM_MINCOV
+
+#endif // BITKERNEL_H
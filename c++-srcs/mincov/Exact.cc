@@ -7,20 +7,24 @@
 /// All rights reserved.
 
 #include "Exact.h"
+#include "Greedy.h"
+#include "BitKernel.h"
 #include "mincov/McMatrix.h"
+#include "mincov/McBlock.h"
 #include "mincov/LbCalc.h"
 #include "mincov/Selector.h"
 #include "ym/JsonValue.h"
 #include "ym/Range.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
 
 
 BEGIN_NAMESPACE_YM_MINCOV
 
 BEGIN_NONAMESPACE
 
-static
-int solve_id = 0;
-
 // 2つの行列が等しいかをチェックする関数
 // 等しくなければ例外を送出する．
 void
@@ -35,27 +39,595 @@ verify_block(
   ASSERT_COND( a.col_head_list() == b.col_head_list() );
 
   for ( int row_pos: Range(a.row_size()) ) {
-    ASSERT_COND( a.row_list(row_pos) == b.row_list(row_pos) );
+    ASSERT_COND( a.row_elems(row_pos) == b.row_elems(row_pos) );
   }
 
   for ( int col_pos: Range(a.col_size()) ) {
-    ASSERT_COND( a.col_list(col_pos) == b.col_list(col_pos) );
+    ASSERT_COND( a.col_elems(col_pos) == b.col_elems(col_pos) );
   }
 }
 
-unique_ptr<LbCalc>
-new_LbCalc(
-  const JsonValue& opt_obj
-)
+END_NONAMESPACE
+
+//////////////////////////////////////////////////////////////////////
+// クラス Exact::Control
+//////////////////////////////////////////////////////////////////////
+class Exact::Control
 {
-  JsonValue lb_opt;
-  if ( opt_obj.has_key("lower_bound") ) {
-    lb_opt = opt_obj.at("lower_bound");
+public:
+
+  // コンストラクタ
+  Control(
+    SizeType node_limit,
+    SizeType time_limit_ms
+  ) : mNodeLimit{node_limit},
+      mTimeLimit{time_limit_ms}
+  {
   }
-  return LbCalc::new_obj(lb_opt);
-}
 
-END_NONAMESPACE
+  // デストラクタ
+  ~Control() = default;
+
+  // 探索を開始する．
+  void
+  start()
+  {
+    mNodeNum = 0;
+    mStop = false;
+    mStopLb = INT_MAX;
+    mDeadline = std::chrono::steady_clock::now()
+      + std::chrono::milliseconds{mTimeLimit};
+  }
+
+  // ノードを数える．
+  // @return ノード番号を返す．
+  //
+  // 制限に達したら探索を打ち切る印をつける．
+  // 時間は 256 ノードごとにしか調べない．
+  SizeType
+  count_node()
+  {
+    SizeType id = mNodeNum ++;
+    if ( mNodeLimit > 0 && id >= mNodeLimit ) {
+      mStop = true;
+    }
+    else if ( mTimeLimit > 0 && (id & 255) == 0 &&
+	      std::chrono::steady_clock::now() >= mDeadline ) {
+      mStop = true;
+    }
+    return id;
+  }
+
+  // 制限時間を過ぎていたら探索を打ち切る印をつける．
+  // @return 探索が打ち切られていたら true を返す．
+  //
+  // count_node() を呼ばずに探索を行う場合に用いる．
+  bool
+  check_time()
+  {
+    if ( mTimeLimit > 0 && std::chrono::steady_clock::now() >= mDeadline ) {
+      mStop = true;
+    }
+    return mStop;
+  }
+
+  // 探索したノード数を返す．
+  SizeType
+  node_num() const
+  {
+    return mNodeNum;
+  }
+
+  // 探索が打ち切られていたら true を返す．
+  bool
+  is_stopped() const
+  {
+    return mStop;
+  }
+
+  // 打ち切られて探索されなかった部分木の下界を記録する．
+  void
+  record_lb(
+    int lb
+  )
+  {
+    int old_lb = mStopLb;
+    while ( lb < old_lb && !mStopLb.compare_exchange_weak(old_lb, lb) ) {
+      ;
+    }
+  }
+
+  // 探索されなかった部分木の下界の最小値を返す．
+  int
+  stop_lb() const
+  {
+    return mStopLb;
+  }
+
+
+private:
+
+  // ノード数の上限(0 なら無制限)
+  SizeType mNodeLimit;
+
+  // 制限時間(ミリ秒，0 なら無制限)
+  SizeType mTimeLimit;
+
+  // 探索を打ち切る時刻
+  std::chrono::steady_clock::time_point mDeadline;
+
+  // 探索したノード数
+  std::atomic<SizeType> mNodeNum{0};
+
+  // 探索を打ち切る時 true
+  std::atomic<bool> mStop{false};
+
+  // 探索されなかった部分木の下界の最小値
+  std::atomic<int> mStopLb{INT_MAX};
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス Exact::MtState
+//////////////////////////////////////////////////////////////////////
+class Exact::MtState
+{
+public:
+
+  // 根からの分岐の1ステップ
+  struct Step
+  {
+    // 列番号
+    SizeType col;
+
+    // 選択した時 true，削除した時 false
+    bool select;
+
+    // 選択した時に，削除側の分岐がまだ誰にも取られていなければ true
+    // 列の固定によるステップは常に false
+    bool open;
+
+    // 再現する時にこのステップの前に縮約を行う時 true
+    // 同じノードでまとめて固定した列の2番目以降は false
+    bool reduce;
+
+    // 分岐したノードの下界
+    int lb;
+  };
+
+  // コンストラクタ
+  MtState(
+    SizeType worker_num,
+    int best
+  ) : mSlotArray(worker_num),
+      mBest{best},
+      mBusyNum{1}
+  {
+  }
+
+  // デストラクタ
+  ~MtState() = default;
+
+  // 現在のベストのコストを返す．
+  int
+  best() const
+  {
+    return mBest;
+  }
+
+  // 現在のベスト解を返す．
+  const vector<SizeType>&
+  best_solution() const
+  {
+    return mBestSolution;
+  }
+
+  // より良い解を登録する．
+  void
+  update(
+    int cost,
+    const vector<SizeType>& solution
+  )
+  {
+    std::lock_guard<std::mutex> lock{mBestMtx};
+    if ( cost < mBest ) {
+      mBest = cost;
+      mBestSolution = solution;
+    }
+  }
+
+  // ワーカーのパスを設定する．
+  void
+  set_path(
+    SizeType id,
+    const vector<Step>& path
+  )
+  {
+    auto& slot = mSlotArray[id];
+    std::lock_guard<std::mutex> lock{slot.mMtx};
+    slot.mPath = path;
+  }
+
+  // ワーカーのパスをクリアする．
+  void
+  clear_path(
+    SizeType id
+  )
+  {
+    auto& slot = mSlotArray[id];
+    std::lock_guard<std::mutex> lock{slot.mMtx};
+    slot.mPath.clear();
+  }
+
+  // ワーカーのパスにステップを追加する．
+  //
+  // open が true のステップの削除側の分岐は他のワーカーから取られうる．
+  void
+  push_step(
+    SizeType id,
+    const Step& step
+  )
+  {
+    {
+      auto& slot = mSlotArray[id];
+      std::lock_guard<std::mutex> lock{slot.mMtx};
+      slot.mPath.push_back(step);
+    }
+    if ( step.open && mIdleNum > 0 ) {
+      // 仕事を待っているワーカーを起こす．
+      std::lock_guard<std::mutex> lock{mWaitMtx};
+      ++ mWorkGen;
+      mWaitCv.notify_all();
+    }
+  }
+
+  // ワーカーのパスの末尾のステップを取り除く．
+  // @return 削除側の分岐が他のワーカーに取られていたら true を返す．
+  bool
+  pop_step(
+    SizeType id
+  )
+  {
+    auto& slot = mSlotArray[id];
+    std::lock_guard<std::mutex> lock{slot.mMtx};
+    auto step = slot.mPath.back();
+    slot.mPath.pop_back();
+    return step.select && !step.open;
+  }
+
+  // 他のワーカーから未探索の部分木を奪う．
+  // @return 奪えたら true を返す．
+  //
+  // 部分木は根に最も近いものを選ぶ．
+  // 奪った部分木の根からのパスを path に設定する．
+  bool
+  steal(
+    SizeType id,
+    vector<Step>& path
+  )
+  {
+    SizeType n = mSlotArray.size();
+    for ( SizeType i = 1; i < n; ++ i ) {
+      auto& slot = mSlotArray[(id + i) % n];
+      std::lock_guard<std::mutex> lock{slot.mMtx};
+      SizeType m = slot.mPath.size();
+      for ( SizeType k = 0; k < m; ++ k ) {
+	auto& step = slot.mPath[k];
+	if ( step.open ) {
+	  step.open = false;
+	  path.clear();
+	  path.reserve(k + 1);
+	  for ( SizeType j = 0; j < k; ++ j ) {
+	    auto step1 = slot.mPath[j];
+	    step1.open = false;
+	    path.push_back(step1);
+	  }
+	  path.push_back(Step{step.col, false, false, true, step.lb});
+	  // 取った側が部分木を探索し終えるまでは終了させない．
+	  ++ mBusyNum;
+	  return true;
+	}
+      }
+    }
+    return false;
+  }
+
+  // 未探索の部分木が現れるまで待ってそれを奪う．
+  // @return 奪えたら true を，探索が終わっていたら false を返す．
+  //
+  // 他のワーカーが分岐するか探索が終わると push_step()/finish() から
+  // 起こされるので，眠っている間 CPU は使わない．
+  bool
+  wait_task(
+    SizeType id,
+    vector<Step>& path
+  )
+  {
+    // steal() の前に mIdleNum を増やしておけば，
+    // push_step() はステップを積んだ後にそれを見て必ず起こしてくれる．
+    ++ mIdleNum;
+    bool stat = false;
+    for ( ; ; ) {
+      if ( mAbort || is_done() ) {
+	break;
+      }
+      SizeType gen = mWorkGen;
+      if ( steal(id, path) ) {
+	stat = true;
+	break;
+      }
+      std::unique_lock<std::mutex> lock{mWaitMtx};
+      mWaitCv.wait(lock, [&]{
+	return mWorkGen != gen || mAbort || is_done();
+      });
+    }
+    -- mIdleNum;
+    return stat;
+  }
+
+  // 部分木の探索を終えた．
+  void
+  finish()
+  {
+    if ( -- mBusyNum == 0 ) {
+      // 待っているワーカーを終了させる．
+      wake_all();
+    }
+  }
+
+  // すべての探索が終わっていたら true を返す．
+  bool
+  is_done() const
+  {
+    return mBusyNum == 0;
+  }
+
+  // 例外を記録して探索を中断する．
+  void
+  set_error(
+    std::exception_ptr error
+  )
+  {
+    std::lock_guard<std::mutex> lock{mBestMtx};
+    if ( !mError ) {
+      mError = error;
+    }
+    mAbort = true;
+    wake_all();
+  }
+
+  // 記録された例外を返す．
+  std::exception_ptr
+  error() const
+  {
+    return mError;
+  }
+
+  // 探索の中断を指示するフラグ
+  std::atomic<bool> mAbort{false};
+
+
+private:
+
+  // 待っているワーカーをすべて起こす．
+  void
+  wake_all()
+  {
+    std::lock_guard<std::mutex> lock{mWaitMtx};
+    ++ mWorkGen;
+    mWaitCv.notify_all();
+  }
+
+  // ワーカーごとのデータ
+  struct Slot
+  {
+    // mPath を保護する mutex
+    std::mutex mMtx;
+
+    // 根からのパス
+    vector<Step> mPath;
+  };
+
+  // ワーカーごとのデータの配列
+  vector<Slot> mSlotArray;
+
+  // 現在のベストのコスト
+  std::atomic<int> mBest;
+
+  // mBestSolution と mError を保護する mutex
+  std::mutex mBestMtx;
+
+  // 現在のベスト解
+  vector<SizeType> mBestSolution;
+
+  // 部分木を探索中のワーカー数
+  std::atomic<SizeType> mBusyNum;
+
+  // ワーカーで送出された例外
+  std::exception_ptr mError;
+
+  // 仕事を待っているワーカー数
+  std::atomic<SizeType> mIdleNum{0};
+
+  // 仕事が公開されるたびに増える番号
+  std::atomic<SizeType> mWorkGen{0};
+
+  // mWaitCv 用の mutex
+  std::mutex mWaitMtx;
+
+  // 仕事の公開と探索の終了を知らせる条件変数
+  std::condition_variable mWaitCv;
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// クラス Exact::TransTable
+//////////////////////////////////////////////////////////////////////
+class Exact::TransTable
+{
+public:
+
+  // 部分問題を表すキー
+  struct Key
+  {
+    // アクティブな行と列の集合のハッシュ値
+    std::uint64_t hash;
+
+    // アクティブな行数
+    SizeType row_num;
+
+    // アクティブな列数
+    SizeType col_num;
+
+    bool
+    operator==(
+      const Key& right
+    ) const
+    {
+      return hash == right.hash &&
+	row_num == right.row_num &&
+	col_num == right.col_num;
+    }
+  };
+
+  // コンストラクタ
+  //
+  // 要素数は size を超えない2のべき乗に切り下げる．
+  TransTable(
+    SizeType size
+  )
+  {
+    SizeType n = 1;
+    while ( n * 2 <= size ) {
+      n *= 2;
+    }
+    mArray.resize(n);
+    mMask = n - 1;
+  }
+
+  // デストラクタ
+  ~TransTable() = default;
+
+  // 行列の現在の状態のキーを返す．
+  static
+  Key
+  key(
+    const McMatrix& matrix
+  )
+  {
+    return Key{matrix.hash(), matrix.active_row_num(), matrix.active_col_num()};
+  }
+
+  // 部分問題の最小コストの下界を探す．
+  // @return 見つかったら true を返す．
+  bool
+  lookup(
+    const Key& key,
+    int& value
+  )
+  {
+    ++ mProbeNum;
+    auto& entry = mArray[key.hash & mMask];
+    if ( entry.valid && entry.key == key ) {
+      ++ mHitNum;
+      value = entry.value;
+      return true;
+    }
+    return false;
+  }
+
+  // 部分問題の最小コストの下界を記録する．
+  //
+  // 同じ場所に別の部分問題があったら置き換える．
+  void
+  record(
+    const Key& key,
+    int value
+  )
+  {
+    ++ mStoreNum;
+    auto& entry = mArray[key.hash & mMask];
+    if ( entry.valid && entry.key == key ) {
+      if ( entry.value < value ) {
+	entry.value = value;
+      }
+      return;
+    }
+    entry = Entry{key, value, true};
+  }
+
+  // 表を空にする．
+  void
+  clear()
+  {
+    for ( auto& entry: mArray ) {
+      entry.valid = false;
+    }
+    mProbeNum = 0;
+    mHitNum = 0;
+    mCutNum = 0;
+    mStoreNum = 0;
+  }
+
+  // 表を引いて枝刈りできた回数を数える．
+  void
+  count_cut()
+  {
+    ++ mCutNum;
+  }
+
+  // 統計情報を出力する．
+  void
+  print_stats(
+    ostream& s
+  ) const
+  {
+    double rate = mProbeNum > 0 ? 100.0 * mHitNum / mProbeNum : 0.0;
+    s << "TransTable: " << mArray.size() << " entries, "
+      << mProbeNum << " probes, "
+      << mHitNum << " hits (" << rate << "%), "
+      << mCutNum << " cuts, "
+      << mStoreNum << " stores" << endl;
+  }
+
+
+private:
+
+  // 表の要素
+  struct Entry
+  {
+    // キー
+    Key key;
+
+    // 部分問題の最小コストの下界
+    int value;
+
+    // 使われている時 true
+    bool valid{false};
+  };
+
+  // 表の本体
+  vector<Entry> mArray;
+
+  // 位置を求めるためのマスク
+  SizeType mMask;
+
+  // 表を引いた回数
+  SizeType mProbeNum{0};
+
+  // 見つかった回数
+  SizeType mHitNum{0};
+
+  // 枝刈りできた回数
+  SizeType mCutNum{0};
+
+  // 記録した回数
+  SizeType mStoreNum{0};
+
+};
+
 
 //////////////////////////////////////////////////////////////////////
 // クラス Exact
@@ -67,8 +639,91 @@ Exact::Exact(
   const JsonValue& opt_obj
 ) : Solver{matrix, opt_obj},
     mLbCalc{new_LbCalc(opt_obj)},
-    mDoPartition{get_bool(opt_obj, "partition")}
+    mSelector{new_Selector(opt_obj)},
+    mDoPartition{get_bool(opt_obj, "partition")},
+    mDoFixing{get_bool(opt_obj, "fixing", true)},
+    mLbStats{get_bool(opt_obj, "lb_stats")},
+    mOption{opt_obj},
+    mThreadNum{get_int(opt_obj, "threads", 1)}
 {
+  if ( mThreadNum < 1 ) {
+    throw std::invalid_argument{"threads should be a positive integer"};
+  }
+  if ( mThreadNum > 1 && mLbCalc->spawns_threads() ) {
+    // 並列探索ではスレッドごと，ブロックごとに LbCalc を作るので
+    // LbCalc が自前のスレッドを作るとスレッド数が際限なく増える．
+    throw std::invalid_argument{"'parallel' lower_bound cannot be used with threads > 1"};
+  }
+
+  auto node_limit = get_int(opt_obj, "node_limit", 0);
+  if ( node_limit < 0 ) {
+    throw std::invalid_argument{"node_limit should be a non-negative integer"};
+  }
+  auto time_limit = get_int(opt_obj, "time_limit_ms", 0);
+  if ( time_limit < 0 ) {
+    throw std::invalid_argument{"time_limit_ms should be a non-negative integer"};
+  }
+  mControlBody = std::unique_ptr<Control>{new Control(node_limit, time_limit)};
+  mControl = mControlBody.get();
+
+  mBitKernelRows = get_int(opt_obj, "bit_kernel", 64);
+  if ( mBitKernelRows < 0 ||
+       static_cast<SizeType>(mBitKernelRows) > BitKernel::MAX_ROWS ) {
+    throw std::invalid_argument{"bit_kernel should be an integer between 0 and 128"};
+  }
+  if ( mBitKernelRows > 0 ) {
+    mBitKernel = std::unique_ptr<BitKernel>{new BitKernel};
+  }
+
+  mTtSize = get_int(opt_obj, "tt_size", 0);
+  if ( mTtSize < 0 ) {
+    throw std::invalid_argument{"tt_size should be a non-negative integer"};
+  }
+
+  // primal heuristic の設定
+  JsonValue sel_list_obj;
+  if ( opt_obj.has_key("primal") ) {
+    auto primal_obj = opt_obj.at("primal");
+    if ( primal_obj.is_bool() ) {
+      mPrimalRoot = primal_obj.get_bool();
+    }
+    else if ( primal_obj.is_object() ) {
+      mPrimalRoot = get_bool(primal_obj, "root", true);
+      mPrimalInterval = get_int(primal_obj, "interval", 0);
+      if ( mPrimalInterval < 0 ) {
+	throw std::invalid_argument{"interval should be a non-negative integer"};
+      }
+      mPrimalCompare = get_bool(primal_obj, "compare", false);
+      if ( primal_obj.has_key("selector") ) {
+	sel_list_obj = primal_obj.at("selector");
+      }
+    }
+    else {
+      throw std::invalid_argument{"primal should be a boolean or a JSON-object"};
+    }
+  }
+  if ( mPrimalRoot || mPrimalInterval > 0 ) {
+    auto new_greedy = [&](const JsonValue& sel_obj) {
+      std::unordered_map<string, JsonValue> greedy_dict;
+      if ( !sel_obj.is_null() ) {
+	greedy_dict.emplace("selector", sel_obj);
+      }
+      auto greedy = new Greedy{matrix, JsonValue{greedy_dict}};
+      mPrimalList.push_back(std::unique_ptr<Greedy>{greedy});
+    };
+    if ( sel_list_obj.is_array() ) {
+      SizeType n = sel_list_obj.size();
+      if ( n == 0 ) {
+	throw std::invalid_argument{"selector list should not be empty"};
+      }
+      for ( SizeType i = 0; i < n; ++ i ) {
+	new_greedy(sel_list_obj[i]);
+      }
+    }
+    else {
+      new_greedy(sel_list_obj);
+    }
+  }
 }
 
 // @brief デストラクタ
@@ -82,22 +737,93 @@ Exact::solve(
   vector<SizeType>& solution
 )
 {
-  solve_id = 0;
+  // 置換表は逐次探索の時だけ用いる．
+  mTransTable.reset();
+  if ( mTtSize > 0 && mThreadNum == 1 ) {
+    mTransTable = std::unique_ptr<TransTable>{new TransTable(mTtSize)};
+  }
+
+  SizeType cold_num = 0;
+  if ( mPrimalCompare ) {
+    // 比較のために primal heuristic なしで解いてノード数を数える．
+    auto primal_root = mPrimalRoot;
+    auto primal_interval = mPrimalInterval;
+    mPrimalRoot = false;
+    mPrimalInterval = 0;
+    mControl->start();
+    mBest = INT_MAX;
+    mCurSolution.clear();
+    matrix().save();
+    _solve(0, 0);
+    matrix().restore();
+    cold_num = mControl->node_num();
+    if ( mTransTable ) {
+      // ノード数を比べられるように空にしておく．
+      mTransTable->clear();
+    }
+    mPrimalRoot = primal_root;
+    mPrimalInterval = primal_interval;
+  }
+
+  mControl->start();
 
   mBest = INT_MAX;
   mCurSolution.clear();
-  bool stat = _solve(0, 0);
-  ASSERT_COND( stat );
+  _solve(0, 0);
+
+  if ( mBest == INT_MAX ) {
+    // 解が得られる前に打ち切られたので Greedy で解を作る．
+    // 根での縮約結果は mCurSolution に残っている．
+    ASSERT_COND( mControl->is_stopped() );
+    Greedy greedy{matrix(), JsonValue{}};
+    vector<SizeType> solution1{mCurSolution};
+    greedy.solve(solution1);
+    mBest = matrix().cost(solution1);
+    mBestSolution = solution1;
+  }
 
   solution = mBestSolution;
 
+  mOptimal = !mControl->is_stopped();
+  if ( mOptimal ) {
+    mLowerBound = mBest;
+  }
+  else {
+    mLowerBound = std::min(mBest, mControl->stop_lb());
+  }
+
   if ( debug() ) {
-    cout << "Total branch: " << solve_id << endl;
+    cout << "Total branch: " << mControl->node_num() << endl;
+    if ( !mOptimal ) {
+      cout << "Search stopped: lower bound = " << mLowerBound << endl;
+    }
+    if ( mBitKernel ) {
+      mBitKernel->print_stats(cout);
+    }
+  }
+  if ( mLbStats ) {
+    mLbCalc->print_stats(cout);
+  }
+  if ( (debug() || mLbStats) && mTransTable ) {
+    mTransTable->print_stats(cout);
+  }
+  if ( mPrimalCompare ) {
+    SizeType node_num = mControl->node_num();
+    cout << "Exact: " << node_num << " nodes"
+	 << " (cold start: " << cold_num << " nodes, "
+	 << static_cast<int>(cold_num - node_num) << " saved)" << endl;
   }
 
   return mBest;
 }
 
+// @brief 直前の solve() で探索したノード数を返す．
+SizeType
+Exact::node_num() const
+{
+  return mControl->node_num();
+}
+
 // @brief 解を求める再帰関数
 bool
 Exact::_solve(
@@ -105,16 +831,102 @@ Exact::_solve(
   int depth
 )
 {
-  int cur_id = solve_id;
-  ++ solve_id;
+  SizeType cur_id = mControl->count_node();
+
+  if ( mControl->is_stopped() ) {
+    // 制限に達したので打ち切る．
+    mControl->record_lb(lb);
+    return false;
+  }
+
+  if ( mAbort != nullptr && *mAbort ) {
+    // 並列に解いている他のブロックで解がなかった．
+    return false;
+  }
+
+  if ( mMtState != nullptr ) {
+    // 他のワーカーが見つけた解で上界を更新する．
+    mBest = std::min(mBest, mMtState->best());
+  }
+
+  // 列の固定でワーカーのパスに積んだステップは戻る時に取り除く．
+  struct StepGuard {
+    MtState* mState;
+    SizeType mId;
+    SizeType mNum{0};
+    ~StepGuard()
+    {
+      for ( SizeType i = 0; i < mNum; ++ i ) {
+	mState->pop_step(mId);
+      }
+    }
+  } step_guard{mMtState, mWorkerId};
+
+  // 戻る時に部分問題の最小コストの下界を置換表に記録する．
+  // 打ち切られずに探索を終えたら，部分問題には mBest を下回る解はない．
+  // このノードで mBest を更新した時は mBest が最小コストそのものだが，
+  // 表には解を記録しないので下界としてしか使えない．
+  struct TtGuard {
+    TtGuard(
+      Exact* self
+    ) : mSelf{self}
+    {
+    }
+    Exact* mSelf;
+    bool mActive{false};
+    TransTable::Key mKey{0, 0, 0};
+    int mBaseCost{0};
+    ~TtGuard()
+    {
+      if ( !mActive || mSelf->mControl->is_stopped() ||
+	   (mSelf->mAbort != nullptr && *mSelf->mAbort) ||
+	   mSelf->mBest == INT_MAX ) {
+	return;
+      }
+      mSelf->mTransTable->record(mKey, mSelf->mBest - mBaseCost);
+    }
+  } tt_guard{this};
+
+  // 置換表を引く．
+  // 縮約後のアクティブな行と列の集合が等しければ同じ部分問題なので，
+  // 以前に求めた下界がそのまま使える．
+  // 置換表は逐次探索の時しか作らないので mMtState は nullptr となる．
+  if ( mTransTable ) {
+    vector<SizeType> dummy;
+    matrix().reduce_loop(mCurSolution, dummy);
+    int base_cost = matrix().cost(mCurSolution);
+    auto key = TransTable::key(matrix());
+    int value;
+    if ( mTransTable->lookup(key, value) ) {
+      if ( lb < base_cost + value ) {
+	lb = base_cost + value;
+      }
+      if ( lb >= mBest ) {
+	mTransTable->count_cut();
+	return false;
+      }
+    }
+    tt_guard.mActive = true;
+    tt_guard.mKey = key;
+    tt_guard.mBaseCost = base_cost;
+  }
 
-  vector<SizeType> dummy;
-  matrix().reduce_loop(mCurSolution, dummy);
+  // 列を固定できる間は縮約と下界の計算を繰り返す．
+  int tmp_cost;
+  for ( ; ; ) {
+    vector<SizeType> dummy;
+    matrix().reduce_loop(mCurSolution, dummy);
 
-  auto tmp_cost = matrix().cost(mCurSolution);
-  auto tmp_lb = mLbCalc->calc(matrix()) + tmp_cost;
-  if ( lb < tmp_lb ) {
-    lb = tmp_lb;
+    tmp_cost = matrix().cost(mCurSolution);
+    // 下界が mBest に達すれば枝刈りできるので，そこで計算を打ち切ってよい．
+    auto tmp_lb = mLbCalc->calc(matrix(), mBest - tmp_cost) + tmp_cost;
+    if ( lb < tmp_lb ) {
+      lb = tmp_lb;
+    }
+    if ( !mDoFixing || lb >= mBest ||
+	 !fix_columns(lb, tmp_cost, step_guard.mNum) ) {
+      break;
+    }
   }
 
   bool cur_debug = debug();
@@ -141,70 +953,75 @@ Exact::_solve(
 
   if ( matrix().active_row_num() == 0 ) {
     // 自明な解
-    mBest = tmp_cost;
-    mBestSolution = mCurSolution;
+    update_best(tmp_cost, mCurSolution);
     if ( cur_debug ) {
       cout << " best" << endl;
     }
     return true;
   }
 
-#if 0
-  McBlock block1(mBlock.matrix());
-  if ( mDoPartition && mBlock.partition(block1) ) {
-    // ブロック分割を行う．
-    Exact solver1(block1, mLbCalcList, mSelector);
-    Exact solver2(block2, mLbCalcList, mSelector);
-    if ( cur_debug ) {
-      cout << endl
-	   << "BLOCK PARTITION" << endl;
-      cout << "Matrix#1" << endl;
-      solver1.block().print(cout);
-      cout << "Matrix#2" << endl;
-      solver2.block().print(cout);
-    }
-
-    block1.save();
-    block2.save();
-    int cost_so_far = mBlock.cost(mCurSolution);
-    int lb_rest = 0;
-    for ( auto lb_calc_p: mLbCalcList ) {
-      int tmp_lb = (*lb_calc_p)(solver1.block());
-      if ( lb_rest < tmp_lb ) {
-	lb_rest = tmp_lb;
+  if ( mBitKernel &&
+       matrix().active_row_num() <= static_cast<SizeType>(mBitKernelRows) ) {
+    // 十分小さくなったのでビット演算で解く．
+    auto stop = [&]() -> bool {
+      return mControl->check_time() || (mAbort != nullptr && *mAbort);
+    };
+    int cost;
+    vector<SizeType> solution;
+    if ( mBitKernel->solve(matrix(), mBest - tmp_cost, stop, cost, solution) ) {
+      vector<SizeType> solution1{mCurSolution};
+      solution1.insert(solution1.end(), solution.begin(), solution.end());
+      update_best(tmp_cost + cost, solution1);
+      if ( cur_debug ) {
+	cout << "[" << depth << "] bit kernel: " << mBest << endl;
       }
+      return true;
     }
-    solver1.mBest = mBest - cost_so_far - lb_rest;
-    solver1.mCurSolution.clear();
-    bool stat1 = solver1._solve(0, depth + 1);
-    if ( stat1 ) {
-      mCurSolution.insert(mCurSolution.end(),
-			  solver1.mBestSolution.begin(), solver1.mBestSolution.end());
-      cost_so_far += solver1.mBest;
-      solver2.mBest = mBest - cost_so_far;
-      solver2.mCurSolution.clear();
-      stat1 = solver2._solve(0, depth + 1);
-      if ( stat1 ) {
-	mCurSolution.insert(mCurSolution.end(),
-			    solver2.mBestSolution.begin(), solver2.mBestSolution.end());
-	cost_so_far += solver2.mBest;
-      }
+    if ( mBitKernel->is_aborted() && mControl->is_stopped() ) {
+      mControl->record_lb(lb);
     }
-    block1.restore();
-    block2.restore();
-    mBlock.merge(block1, block2);
+    return false;
+  }
 
-    if ( stat1 ) {
-      ASSERT_COND( mBlock.verify(mCurSolution) );
-      if ( mBest > cost_so_far ) {
-	mBest = cost_so_far;
-	mBestSolution = mCurSolution;
-	return true;
+  if ( mDoPartition ) {
+    auto block_list = McBlock::partition(matrix());
+    if ( block_list.size() > 1 ) {
+      // ブロックごとに独立に解く．
+      if ( cur_debug ) {
+	cout << "[" << depth << "] BLOCK PARTITION: "
+	     << block_list.size() << " blocks" << endl;
       }
+      bool stat = solve_blocks(block_list, tmp_cost, depth);
+      if ( mControl->is_stopped() ) {
+	// ブロックの探索が打ち切られた．
+	mControl->record_lb(lb);
+      }
+      return stat;
     }
-    return false;
   }
-#endif
+
+  if ( (depth == 0 && mPrimalRoot) ||
+       (depth > 0 && mPrimalInterval > 0 && cur_id % mPrimalInterval == 0) ) {
+    // ヒューリスティックで解を求めて上界を更新する．
+    auto old_best = mBest;
+    run_primal();
+    if ( cur_debug && mBest < old_best ) {
+      cout << "[" << depth << "] primal heuristic: " << mBest << endl;
+    }
+    if ( lb >= mBest ) {
+      // 下界に一致する解が得られた．
+      return mBest < old_best;
+    }
+  }
+
+  if ( mThreadNum > 1 ) {
+    // ここから先は複数のスレッドで探索する．
+    bool stat = solve_mt();
+    if ( mControl->is_stopped() ) {
+      mControl->record_lb(lb);
+    }
+    return stat;
+  }
 
   // 次の分岐のための列をとってくる．
   SizeType col = mSelector->select(matrix());
@@ -220,6 +1037,9 @@ Exact::_solve(
   // その列を選択したときの最良解を求める．
   matrix().select_col(col);
   mCurSolution.push_back(col);
+  if ( mMtState != nullptr ) {
+    mMtState->push_step(mWorkerId, MtState::Step{col, true, true, true, lb});
+  }
 
   if ( cur_debug ) {
     cout << "[" << depth << "]A select column#" << col << endl;
@@ -232,6 +1052,13 @@ Exact::_solve(
   for ( SizeType i = 0; i < c; ++ i ) {
     mCurSolution.pop_back();
   }
+  if ( mMtState != nullptr && mMtState->pop_step(mWorkerId) ) {
+    // 選択しなかった時の部分木は他のワーカーが探索する．
+    if ( cur_debug ) {
+      cout << "[" << depth << "]C stolen" << endl;
+    }
+    return stat1;
+  }
 
 #if defined(VERIFYY_MINCOV)
   verify_matrix(orig_matrix, matrix());
@@ -246,6 +1073,12 @@ Exact::_solve(
     return true;
   }
 
+  if ( mControl->is_stopped() ) {
+    // 選択しなかった時の部分木は探索されない．
+    mControl->record_lb(lb);
+    return stat1;
+  }
+
   // その列を選択しなかったときの最良解を求める．
   matrix().delete_col(col);
 
@@ -253,9 +1086,452 @@ Exact::_solve(
     cout << "[" << depth << "]B deselect column#" << col << endl;
   }
 
+  if ( mMtState != nullptr ) {
+    mMtState->push_step(mWorkerId, MtState::Step{col, false, false, true, lb});
+  }
+
   bool stat2 = _solve(lb, depth + 1);
 
+  if ( mMtState != nullptr ) {
+    mMtState->pop_step(mWorkerId);
+  }
+
   return stat1 || stat2;
 }
 
+// @brief 被約費用を用いて列を固定する．
+bool
+Exact::fix_columns(
+  int& lb,
+  int tmp_cost,
+  SizeType& step_num
+)
+{
+  auto rc_array = mLbCalc->reduced_cost();
+  if ( rc_array == nullptr || mBest == INT_MAX ) {
+    return false;
+  }
+
+  // 緩和問題の値は列 j を選ぶと rc_j 増え，
+  // rc_j が負の列を選ばないと -rc_j 増える．
+  // コストは整数なので切り上げて mBest と比較する．
+  double base = tmp_cost + mLbCalc->relaxed_value();
+  vector<SizeType> sel_list;
+  vector<SizeType> del_list;
+  for ( auto col_pos: matrix().col_head_list() ) {
+    double rc = (*rc_array)[col_pos];
+    if ( rc > 0.0 && ceil(base + rc - 1e-6) >= mBest ) {
+      del_list.push_back(col_pos);
+    }
+    else if ( rc < 0.0 && ceil(base - rc - 1e-6) >= mBest ) {
+      sel_list.push_back(col_pos);
+    }
+  }
+  if ( sel_list.empty() && del_list.empty() ) {
+    return false;
+  }
+
+  // ワーカーの時は固定した列もパスに積んで他のワーカーが再現できるようにする．
+  // 再現する時の縮約はこの呼び出しの最初のステップの前でだけ行う．
+  bool reduce = true;
+  auto push_step = [&](SizeType col_pos, bool select) {
+    if ( mMtState != nullptr ) {
+      mMtState->push_step(mWorkerId,
+			  MtState::Step{col_pos, select, false, reduce, lb});
+      reduce = false;
+      ++ step_num;
+    }
+  };
+
+  for ( auto col_pos: sel_list ) {
+    matrix().select_col(col_pos);
+    mCurSolution.push_back(col_pos);
+    push_step(col_pos, true);
+  }
+
+  vector<SizeType> row_list;
+  for ( auto col_pos: del_list ) {
+    if ( matrix().col_deleted(col_pos) ) {
+      continue;
+    }
+    matrix().with_lists([&](const auto& lists) {
+      for ( auto row_pos: lists.col_list(col_pos) ) {
+	row_list.push_back(row_pos);
+      }
+    });
+    matrix().delete_col(col_pos);
+    push_step(col_pos, false);
+  }
+
+  // 削除した列にしか含まれていなかった行は被覆できない．
+  for ( auto row_pos: row_list ) {
+    if ( !matrix().row_deleted(row_pos) &&
+	 matrix().row_elem_num(row_pos) == 0 ) {
+      lb = INT_MAX;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// @brief より良い解が見つかった時の処理を行う．
+void
+Exact::update_best(
+  int cost,
+  const vector<SizeType>& solution
+)
+{
+  mBest = cost;
+  mBestSolution = solution;
+  if ( mMtState != nullptr ) {
+    mMtState->update(cost, solution);
+  }
+}
+
+// @brief 現在の行列に対して primal heuristic を行う．
+void
+Exact::run_primal()
+{
+  for ( auto& greedy: mPrimalList ) {
+    // Greedy は行列を書き換えるので前後で save()/restore() を行う．
+    vector<SizeType> solution{mCurSolution};
+    matrix().save();
+    int cost = greedy->solve(solution);
+    matrix().restore();
+    if ( cost < mBest ) {
+      update_best(cost, solution);
+    }
+  }
+}
+
+// @brief 現在のノード以下を複数のスレッドで並列に探索する．
+bool
+Exact::solve_mt()
+{
+  // 現在のアクティブな部分を1つのブロックとみなして
+  // ワーカーごとの行列を作る．
+  vector<SizeType> row_list;
+  row_list.reserve(matrix().active_row_num());
+  for ( auto row_pos: matrix().row_head_list() ) {
+    row_list.push_back(row_pos);
+  }
+  std::sort(row_list.begin(), row_list.end());
+  vector<SizeType> col_list;
+  col_list.reserve(matrix().active_col_num());
+  for ( auto col_pos: matrix().col_head_list() ) {
+    if ( matrix().col_elem_num(col_pos) > 0 ) {
+      col_list.push_back(col_pos);
+    }
+  }
+  std::sort(col_list.begin(), col_list.end());
+  McBlock block{std::move(row_list), std::move(col_list)};
+
+  SizeType n = mThreadNum;
+  MtState state{n, mBest};
+  vector<std::unique_ptr<McMatrix>> matrix_list(n);
+  vector<std::unique_ptr<Exact>> worker_list(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    matrix_list[i] = block.new_matrix(matrix());
+    auto worker = new Exact{*matrix_list[i], mOption};
+    worker->mThreadNum = 1;
+    worker->mAbort = &state.mAbort;
+    worker->mControl = mControl;
+    worker->mMtState = &state;
+    worker->mWorkerId = i;
+    // 根での primal heuristic はすでに行っている．
+    worker->mPrimalRoot = false;
+    worker_list[i] = std::unique_ptr<Exact>{worker};
+  }
+
+  vector<std::thread> thread_list;
+  thread_list.reserve(n - 1);
+  for ( SizeType i = 1; i < n; ++ i ) {
+    thread_list.push_back(std::thread{[&, i]() { worker_list[i]->run_worker(); }});
+  }
+  worker_list[0]->run_worker();
+  for ( auto& th: thread_list ) {
+    th.join();
+  }
+
+  for ( auto& worker: worker_list ) {
+    mLbCalc->merge_stats(*worker->mLbCalc);
+  }
+
+  if ( state.error() ) {
+    std::rethrow_exception(state.error());
+  }
+  if ( state.best() >= mBest ) {
+    return false;
+  }
+
+  for ( auto col_id: state.best_solution() ) {
+    mCurSolution.push_back(block.col_list()[col_id]);
+  }
+  update_best(matrix().cost(mCurSolution), mCurSolution);
+  return true;
+}
+
+// @brief 並列探索のワーカーとして部分木を探索する．
+void
+Exact::run_worker()
+{
+  auto& state = *mMtState;
+  vector<MtState::Step> path;
+  // 最初はワーカー0が根から探索する．
+  bool has_task = mWorkerId == 0;
+  for ( ; ; ) {
+    if ( !has_task ) {
+      if ( mControl->is_stopped() ) {
+	return;
+      }
+      // 他のワーカーが分岐するのを待つ．
+      if ( !state.wait_task(mWorkerId, path) ) {
+	return;
+      }
+    }
+    has_task = false;
+
+    try {
+      // 根からのパスを再現する．
+      // _solve() と同じ順序で縮約と分岐を行うので同じ状態になる．
+      state.set_path(mWorkerId, path);
+      matrix().save();
+      mCurSolution.clear();
+      vector<SizeType> dummy;
+      for ( auto& step: path ) {
+	if ( step.reduce ) {
+	  matrix().reduce_loop(mCurSolution, dummy);
+	}
+	// 元のワーカーと同じ状態になっているので列は残っているはず
+	ASSERT_COND( !matrix().col_deleted(step.col) );
+	if ( step.select ) {
+	  matrix().select_col(step.col);
+	  mCurSolution.push_back(step.col);
+	}
+	else {
+	  matrix().delete_col(step.col);
+	}
+      }
+      mBest = state.best();
+      int lb = path.empty() ? 0 : path.back().lb;
+      _solve(lb, path.size());
+      matrix().restore();
+    }
+    catch ( ... ) {
+      state.set_error(std::current_exception());
+    }
+    state.clear_path(mWorkerId);
+    state.finish();
+  }
+}
+
+// @brief ブロックごとに解を求める．
+bool
+Exact::solve_blocks(
+  const vector<McBlock>& block_list,
+  int cost_so_far,
+  int depth
+)
+{
+  // ブロックごとの行列とソルバを作り，下界を求める．
+  // 各ソルバは自前の LbCalc と Selector を持つ．
+  // LbCalc は前回の計算結果を再利用するので，下界もブロックのソルバの
+  // LbCalc で求める．
+  // ブロックの中では並列化しない．
+  SizeType n = block_list.size();
+  vector<std::unique_ptr<McMatrix>> matrix_list(n);
+  vector<std::unique_ptr<Exact>> solver_list(n);
+  vector<int> lb_list(n);
+  int lb_sum = 0;
+  for ( SizeType i = 0; i < n; ++ i ) {
+    matrix_list[i] = block_list[i].new_matrix(matrix());
+    auto solver = new Exact{*matrix_list[i], mOption};
+    solver->mThreadNum = 1;
+    solver->mAbort = mAbort;
+    solver->mControl = mControl;
+    solver_list[i] = std::unique_ptr<Exact>{solver};
+    lb_list[i] = solver->mLbCalc->calc(*matrix_list[i]);
+    lb_sum += lb_list[i];
+  }
+  if ( cost_so_far + lb_sum >= mBest ) {
+    // 下界の和で枝刈りできる．
+    for ( auto& solver: solver_list ) {
+      mLbCalc->merge_stats(*solver->mLbCalc);
+    }
+    return false;
+  }
+
+  if ( mThreadNum > 1 ) {
+    return solve_blocks_mt(block_list, solver_list, lb_list, cost_so_far, depth);
+  }
+
+  // 小さいブロックから解く．
+  // 小さいブロックのほうが速く解けて，残りのブロックの上界が厳しくなる．
+  vector<SizeType> order(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(),
+	    [&](SizeType a, SizeType b) {
+	      return block_list[a].row_num() < block_list[b].row_num();
+	    });
+
+  // 各ブロックは「全体で mBest を下回る」のに必要な上界のもとで解く．
+  // 未解決のブロックは下界分のコストがかかるとみなす．
+  SizeType cur_n = mCurSolution.size();
+  bool found = true;
+  for ( auto i: order ) {
+    lb_sum -= lb_list[i];
+    auto& solver = *solver_list[i];
+    int budget = mBest - cost_so_far - lb_sum;
+    solver.mBest = budget;
+    solver.mCurSolution.clear();
+    solver._solve(lb_list[i], depth + 1);
+    if ( solver.mBest >= budget ) {
+      // このブロックで上界を下回る解がなかった．
+      found = false;
+      break;
+    }
+    cost_so_far += solver.mBest;
+    auto& col_list = block_list[i].col_list();
+    for ( auto col_id: solver.mBestSolution ) {
+      mCurSolution.push_back(col_list[col_id]);
+    }
+  }
+
+  for ( auto& solver: solver_list ) {
+    mLbCalc->merge_stats(*solver->mLbCalc);
+  }
+
+  if ( !found ) {
+    mCurSolution.erase(mCurSolution.begin() + cur_n, mCurSolution.end());
+    return false;
+  }
+
+  ASSERT_COND( cost_so_far < mBest );
+  update_best(cost_so_far, mCurSolution);
+  return true;
+}
+
+// @brief ブロックを複数のスレッドで並列に解く．
+bool
+Exact::solve_blocks_mt(
+  const vector<McBlock>& block_list,
+  const vector<std::unique_ptr<Exact>>& solver_list,
+  const vector<int>& lb_list,
+  int cost_so_far,
+  int depth
+)
+{
+  SizeType n = block_list.size();
+
+  // どれかのブロックで解がなかったら他のブロックの探索も中断する．
+  std::atomic<bool> abort{false};
+  for ( auto& solver: solver_list ) {
+    solver->mAbort = &abort;
+  }
+
+  // 大きいブロックから取り出すことで負荷の偏りを減らす．
+  vector<SizeType> order(n);
+  for ( SizeType i = 0; i < n; ++ i ) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(),
+	    [&](SizeType a, SizeType b) {
+	      return block_list[a].row_num() > block_list[b].row_num();
+	    });
+
+  // 以下の変数は mutex で保護される．
+  std::mutex mtx;
+  SizeType next = 0;
+  // 解き終わったブロックのコストの和
+  int done_cost = 0;
+  // 解き終わっていないブロックの下界の和
+  int rest_lb = 0;
+  for ( auto lb: lb_list ) {
+    rest_lb += lb;
+  }
+  std::exception_ptr error;
+
+  auto worker = [&]() {
+    for ( ; ; ) {
+      SizeType i;
+      int budget;
+      {
+	std::lock_guard<std::mutex> lock{mtx};
+	if ( abort || next == n ) {
+	  return;
+	}
+	i = order[next];
+	++ next;
+	// 他のブロックは解き終わったものは実際のコスト，
+	// そうでないものは下界分のコストがかかるとみなす．
+	budget = mBest - cost_so_far - done_cost - (rest_lb - lb_list[i]);
+      }
+      auto& solver = *solver_list[i];
+      solver.mBest = budget;
+      solver.mCurSolution.clear();
+      bool stat = false;
+      try {
+	solver._solve(lb_list[i], depth + 1);
+	stat = solver.mBest < budget;
+      }
+      catch ( ... ) {
+	std::lock_guard<std::mutex> lock{mtx};
+	if ( !error ) {
+	  error = std::current_exception();
+	}
+      }
+      std::lock_guard<std::mutex> lock{mtx};
+      if ( !stat ) {
+	// このブロックで上界を下回る解がなかったので
+	// 全体でも mBest を下回る解はない．
+	abort = true;
+	return;
+      }
+      done_cost += solver.mBest;
+      rest_lb -= lb_list[i];
+    }
+  };
+
+  SizeType nt = std::min<SizeType>(mThreadNum, n);
+  vector<std::thread> thread_list;
+  thread_list.reserve(nt - 1);
+  for ( SizeType i = 1; i < nt; ++ i ) {
+    thread_list.push_back(std::thread{worker});
+  }
+  worker();
+  for ( auto& th: thread_list ) {
+    th.join();
+  }
+
+  for ( auto& solver: solver_list ) {
+    mLbCalc->merge_stats(*solver->mLbCalc);
+  }
+
+  if ( error ) {
+    std::rethrow_exception(error);
+  }
+  if ( abort ) {
+    return false;
+  }
+
+  // 各ブロックの上界は他のブロックの下界を用いて見積もっているので，
+  // 合計が mBest を下回るとは限らない．
+  int total_cost = cost_so_far + done_cost;
+  if ( total_cost >= mBest ) {
+    return false;
+  }
+
+  for ( SizeType i = 0; i < n; ++ i ) {
+    auto& col_list = block_list[i].col_list();
+    for ( auto col_id: solver_list[i]->mBestSolution ) {
+      mCurSolution.push_back(col_list[col_id]);
+    }
+  }
+  update_best(total_cost, mCurSolution);
+  return true;
+}
+
 END_NAMESPACE_YM_MINCOV
@@ -9,13 +9,55 @@
 /// All rights reserved.
 
 #include "Solver.h"
+#include "ym/JsonValue.h"
+#include <atomic>
 
 
 BEGIN_NAMESPACE_YM_MINCOV
 
+class Greedy;
+class BitKernel;
+
 //////////////////////////////////////////////////////////////////////
 /// @class Exact Exact.h "Exact.h"
 /// @brief 最小被覆問題の厳密解を求めるクラス
+///
+/// * "partition" オプションが true の時は，分岐の前に行列を
+///   ブロック(連結成分)に分割し，ブロックごとに解を求める．
+/// * "threads" オプションで 2 以上を指定した時は複数のスレッドで
+///   並列に探索する．
+///   - 分岐の前にブロックに分割できた時はブロックごとに並列に解く．
+///   - そうでなければ work-stealing による並列分枝限定法を行う．
+///     各スレッドは自前の行列を持ち，他のスレッドの未探索の部分木を
+///     根からの列の選択/削除の列として受け取って再現する．
+///   - スレッドやブロックごとに下界の計算クラスを作るので，
+///     自前のスレッドを作る下界("parallel" が true の "MAX")とは
+///     組み合わせられない．
+/// * "primal" オプションで初期解を求めるヒューリスティックを制御する．
+///   - false の時は行わない．
+///   - true か省略時は根で Greedy を1回行う．
+///   - JSON オブジェクトの時は以下のキーを持つ．
+///     - "selector": Greedy で用いる Selector のオプション．
+///       配列の時は各々の Selector で Greedy を行い最良のものを用いる．
+///     - "root": 根で行う時 true(デフォルトは true)
+///     - "interval": 内部のノードで行う間隔(デフォルトは 0 で行わない)
+///     - "compare": true の時は初期解なしの場合とノード数を比較して表示する．
+/// * "fixing" オプションが true か省略時は，下界の計算で被約費用が
+///   得られた場合に，それを用いて列の選択/削除を固定する．
+/// * "lb_stats" オプションが true の時は solve() の最後に下界の計算の
+///   統計情報を出力する．
+/// * "bit_kernel" オプションで指定した行数(デフォルトは 64，最大 128)
+///   以下になった部分問題は BitKernel で解く．0 の時は用いない．
+///   BitKernel の中の探索はノード数に数えない．
+/// * "tt_size" オプションで置換表の要素数を指定する(デフォルトは 0 で
+///   用いない)．異なる分岐の順番で同じ部分問題(アクティブな行と列
+///   の集合が等しい行列)に達した時に，以前に求めた最小コストの下界で
+///   枝刈りする．置換表は逐次探索の時だけ用いる．
+///   列の選択/削除による分岐では同じ部分問題に達することは少ないので，
+///   デフォルトでは用いない．
+///   "lb_stats" が true の時は置換表のヒット率も出力する．
+/// * "time_limit_ms" と "node_limit" で探索を打ち切ることができる．
+///   打ち切った時はそれまでの最良解を返し，is_optimal() が false になる．
 //////////////////////////////////////////////////////////////////////
 class Exact :
   public Solver
@@ -44,6 +86,24 @@ public:
     vector<SizeType>& solution ///< [out] 選ばれた列集合
   ) override;
 
+  /// @brief 直前の solve() で最適性が証明されたか調べる．
+  bool
+  is_optimal() const override
+  {
+    return mOptimal;
+  }
+
+  /// @brief 直前の solve() で得られた下界を返す．
+  SizeType
+  lower_bound() const override
+  {
+    return mLowerBound;
+  }
+
+  /// @brief 直前の solve() で探索したノード数を返す．
+  SizeType
+  node_num() const override;
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -57,6 +117,72 @@ private:
     int depth
   );
 
+  /// @brief 被約費用を用いて列を固定する．
+  /// @retval true 固定した列があったので縮約と下界の計算をやり直す．
+  /// @retval false 固定した列がなかったか，被覆できない行が生じた．
+  ///
+  /// 選択すると下界が mBest 以上になる列は削除し，
+  /// 選択しないと下界が mBest 以上になる列は選択する．
+  /// 固定は行列の save()/restore() で元に戻される．
+  /// 被覆できない行が生じた時は lb を INT_MAX にする．
+  bool
+  fix_columns(
+    int& lb,            ///< [inout] 現在のノードの下界
+    int tmp_cost,       ///< [in] 現在の解のコスト
+    SizeType& step_num  ///< [inout] ワーカーのパスに積んだステップ数
+  );
+
+  /// @brief より良い解が見つかった時の処理を行う．
+  void
+  update_best(
+    int cost,                        ///< [in] 解のコスト
+    const vector<SizeType>& solution ///< [in] 解
+  );
+
+  /// @brief 現在の行列に対して primal heuristic を行う．
+  ///
+  /// mBest よりも良い解が見つかったら update_best() を呼ぶ．
+  void
+  run_primal();
+
+  /// @brief 現在のノード以下を複数のスレッドで並列に探索する．
+  /// @retval true mBest よりもよい解が見つかった．
+  /// @retval false mBest よりもよい解はなかった．
+  bool
+  solve_mt();
+
+  /// @brief 並列探索のワーカーとして部分木を探索する．
+  ///
+  /// 探索すべき部分木がなくなるまで他のワーカーから部分木を奪って探索する．
+  void
+  run_worker();
+
+  /// @brief ブロックごとに解を求める．
+  /// @retval true mBest よりもよい解が見つかった．
+  /// @retval false mBest よりもよい解はなかった．
+  ///
+  /// 見つかった解は mCurSolution に追加され，mBestSolution に記録される．
+  bool
+  solve_blocks(
+    const vector<McBlock>& block_list, ///< [in] ブロックのリスト
+    int cost_so_far,                   ///< [in] ここまでの解のコスト
+    int depth                          ///< [in] 探索の深さ
+  );
+
+  /// @brief ブロックを複数のスレッドで並列に解く．
+  /// @retval true mBest よりもよい解が見つかった．
+  /// @retval false mBest よりもよい解はなかった．
+  ///
+  /// solve_blocks() から呼ばれる．
+  bool
+  solve_blocks_mt(
+    const vector<McBlock>& block_list,                  ///< [in] ブロックのリスト
+    const vector<std::unique_ptr<Exact>>& solver_list,  ///< [in] ブロックごとのソルバ
+    const vector<int>& lb_list,                         ///< [in] ブロックごとの下界
+    int cost_so_far,                                    ///< [in] ここまでの解のコスト
+    int depth                                           ///< [in] 探索の深さ
+  );
+
 
 private:
   //////////////////////////////////////////////////////////////////////
@@ -81,6 +207,78 @@ private:
   // block_partition を行うとき true にするフラグ
   bool mDoPartition;
 
+  // 被約費用による列の固定を行う時 true にするフラグ
+  bool mDoFixing;
+
+  // 下界の計算の統計情報を出力する時 true にするフラグ
+  bool mLbStats;
+
+  // ブロックごとのソルバを作るためのオプション
+  JsonValue mOption;
+
+  // 並列に解く時のスレッド数
+  int mThreadNum;
+
+  // 探索の中断を指示するフラグ
+  // 並列に解いているブロックのどれかで解がなかった時にセットされる．
+  const std::atomic<bool>* mAbort{nullptr};
+
+  // 探索全体で共有する制御情報
+  class Control;
+
+  // mControl の実体
+  // ブロックごとのソルバやワーカーは親のものを共有する．
+  std::unique_ptr<Control> mControlBody;
+
+  // 探索全体で共有する制御情報
+  Control* mControl;
+
+  // 直前の solve() で最適性が証明された時 true
+  bool mOptimal{false};
+
+  // 直前の solve() で得られた下界
+  SizeType mLowerBound{0};
+
+  // 並列分枝限定法の共有データ
+  class MtState;
+
+  // ワーカーとして動いている時の共有データ
+  MtState* mMtState{nullptr};
+
+  // ワーカー番号
+  SizeType mWorkerId{0};
+
+  // 根で primal heuristic を行う時 true
+  bool mPrimalRoot{true};
+
+  // 内部のノードで primal heuristic を行う間隔
+  // 0 の時は行わない．
+  int mPrimalInterval{0};
+
+  // 初期解なしの場合とノード数を比較する時 true
+  bool mPrimalCompare{false};
+
+  // primal heuristic で用いる Greedy のリスト
+  vector<std::unique_ptr<Greedy>> mPrimalList;
+
+  // BitKernel で解く行数の上限
+  // 0 の時は用いない．
+  int mBitKernelRows{0};
+
+  // 小さな部分問題を解くクラス
+  std::unique_ptr<BitKernel> mBitKernel;
+
+  // 置換表の要素数
+  // 0 の時は用いない．
+  int mTtSize{0};
+
+  // 部分問題の下界を記録する置換表
+  class TransTable;
+
+  // mTransTable の実体
+  // solve() の中で作られる．
+  std::unique_ptr<TransTable> mTransTable;
+
 };
 
 END_NAMESPACE_YM_MINCOV
@@ -24,8 +24,12 @@ Greedy::Greedy(
   McMatrix& matrix,
   const JsonValue& opt_obj
 ) : Solver{matrix, opt_obj},
-    mSelector{new_Selector(opt_obj)}
+    mSelector{new_Selector(opt_obj)},
+    mLazy{get_bool(opt_obj, "lazy")}
 {
+  if ( mLazy && !mSelector->has_score() ) {
+    throw std::invalid_argument{"lazy greedy requires a selector with column scores"};
+  }
 }
 
 // @grief greedy アルゴリズムで解を求める．
@@ -39,6 +43,11 @@ Greedy::solve(
     matrix().print(cout);
   }
 
+  if ( mLazy ) {
+    solve_lazy(solution);
+    return matrix().cost(solution);
+  }
+
   while ( matrix().active_row_num() > 0 ) {
     // 次の分岐のための列をとってくる．
     auto col = mSelector->select(matrix());
@@ -67,4 +76,96 @@ Greedy::solve(
   return matrix().cost(solution);
 }
 
+// @brief lazy evaluation を用いて解を求める．
+void
+Greedy::solve_lazy(
+  vector<SizeType>& solution
+)
+{
+  // 縮約は行わず，選んだ列の行を削除するだけにする．
+  // そうすると残りの行の要素数は変わらないので，各列の評価値は
+  // 下がる一方となる．
+  // そのためヒープの値は評価値の上界となり，取り出した列の評価値を
+  // 計算し直した値が次の候補の値以上ならそれが最大となる．
+  SizeType base_n = solution.size();
+
+  // 最大ヒープの要素 (評価値, 列番号)
+  // 各列はヒープに高々1つしか入っていない．
+  using Entry = std::pair<double, SizeType>;
+  vector<Entry> heap;
+  heap.reserve(matrix().active_col_num());
+  for ( auto col_pos: matrix().col_head_list() ) {
+    heap.push_back(Entry{mSelector->score(matrix(), col_pos), col_pos});
+  }
+  std::make_heap(heap.begin(), heap.end());
+
+  matrix().save();
+  while ( matrix().active_row_num() > 0 ) {
+    ASSERT_COND( !heap.empty() );
+    auto col = heap.front().second;
+    std::pop_heap(heap.begin(), heap.end());
+    heap.pop_back();
+    if ( matrix().col_elem_num(col) == 0 ) {
+      // すべての行が被覆済み
+      continue;
+    }
+    auto score = mSelector->score(matrix(), col);
+    if ( !heap.empty() && score < heap.front().first ) {
+      // 次の候補の方が良いかもしれないので戻す．
+      heap.push_back(Entry{score, col});
+      std::push_heap(heap.begin(), heap.end());
+      continue;
+    }
+    if ( debug() ) {
+      cout << "Col#" << col << " is selected heuristically" << endl;
+    }
+    matrix().select_col(col);
+    solution.push_back(col);
+  }
+  matrix().restore();
+
+  // 縮約を行っていないので冗長な列が含まれうる．
+  // コストの大きい列から順に，他の列だけで被覆できるものを取り除く．
+  vector<SizeType> cover_num(matrix().row_size(), 0);
+  matrix().with_lists([&](const auto& lists) {
+    for ( SizeType i = base_n; i < solution.size(); ++ i ) {
+      for ( auto row_pos: lists.col_list(solution[i]) ) {
+	++ cover_num[row_pos];
+      }
+    }
+  });
+  vector<SizeType> order;
+  order.reserve(solution.size() - base_n);
+  for ( SizeType i = solution.size(); i -- > base_n; ) {
+    order.push_back(solution[i]);
+  }
+  std::stable_sort(order.begin(), order.end(),
+		   [&](SizeType a, SizeType b) {
+		     return matrix().col_cost(a) > matrix().col_cost(b);
+		   });
+  vector<bool> removed(matrix().col_size(), false);
+  matrix().with_lists([&](const auto& lists) {
+    for ( auto col_pos: order ) {
+      bool redundant = true;
+      for ( auto row_pos: lists.col_list(col_pos) ) {
+	if ( cover_num[row_pos] < 2 ) {
+	  redundant = false;
+	  break;
+	}
+      }
+      if ( redundant ) {
+	removed[col_pos] = true;
+	for ( auto row_pos: lists.col_list(col_pos) ) {
+	  -- cover_num[row_pos];
+	}
+      }
+    }
+  });
+  auto end = std::remove_if(solution.begin() + base_n, solution.end(),
+			    [&](SizeType col_pos) {
+			      return removed[col_pos];
+			    });
+  solution.erase(end, solution.end());
+}
+
 END_NAMESPACE_YM_MINCOV
@@ -16,6 +16,16 @@ BEGIN_NAMESPACE_YM_MINCOV
 //////////////////////////////////////////////////////////////////////
 /// @class Greedy Greedy.h "Greedy.h"
 /// @brief Minimum Covering 問題を greedy に解くクラス
+///
+/// "lazy" オプションが true の時は列の評価値を最大ヒープに入れておき，
+/// 取り出した列の評価値だけを計算し直す(lazy evaluation)．
+/// - 計算し直した値が次の候補の値以上ならその列を選ぶ．
+/// - そうでなければ新しい値でヒープに戻す．
+/// 毎回すべての列を評価する必要がないので大きな行列で速い．
+/// - 評価値が下がる一方となるように途中で縮約は行わない．
+///   代わりに最後に冗長な列を取り除く．
+/// - 行列は solve() を呼ぶ前の状態に戻される．
+/// - Selector は has_score() が true のもの("simple" か "naive")に限られる．
 //////////////////////////////////////////////////////////////////////
 class Greedy :
   public Solver
@@ -41,6 +51,18 @@ public:
   ) override;
 
 
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief lazy evaluation を用いて解を求める．
+  void
+  solve_lazy(
+    vector<SizeType>& solution ///< [out] 選ばれた列集合
+  );
+
+
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
@@ -49,6 +71,9 @@ private:
   // 列を選択するクラス
   std::unique_ptr<Selector> mSelector;
 
+  // lazy evaluation を行う時 true にするフラグ
+  bool mLazy;
+
 };
 
 END_NAMESPACE_YM_MINCOV
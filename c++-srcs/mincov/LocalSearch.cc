@@ -0,0 +1,469 @@
+﻿
+/// @file LocalSearch.cc
+/// @brief LocalSearch の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "LocalSearch.h"
+#include <cstdint>
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+// クラス LocalSearch
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+LocalSearch::LocalSearch(
+  SizeType row_size,
+  const vector<SizeType>& col_cost_array,
+  const vector<MinCov::ElemType>& elem_list,
+  const JsonValue& opt_obj
+) : mRowSize{row_size},
+    mColSize{col_cost_array.size()},
+    mCostArray{col_cost_array}
+{
+  if ( opt_obj.is_object() ) {
+    auto get_bool = [&](const string& key, bool default_val) -> bool {
+      if ( !opt_obj.has_key(key) ) {
+	return default_val;
+      }
+      auto val_obj = opt_obj.at(key);
+      if ( !val_obj.is_bool() ) {
+	ostringstream buf;
+	buf << key << " should be boolean";
+	throw std::invalid_argument{buf.str()};
+      }
+      return val_obj.get_bool();
+    };
+    // 非負の整数のパラメータを取り出す．
+    auto get_int = [&](const string& key, int default_val) -> SizeType {
+      if ( !opt_obj.has_key(key) ) {
+	return default_val;
+      }
+      auto val_obj = opt_obj.at(key);
+      if ( !val_obj.is_int() || val_obj.get_int() < 0 ) {
+	ostringstream buf;
+	buf << key << " should be a non-negative integer";
+	throw std::invalid_argument{buf.str()};
+      }
+      return val_obj.get_int();
+    };
+    mSwap1 = get_bool("swap1", true);
+    mSwap2 = get_bool("swap2", true);
+    mMaxPass = get_int("max_pass", 0);
+    mTimeLimit = get_int("time_limit_ms", 0);
+    mStats = get_bool("stats", false);
+  }
+
+  // 重複した要素を取り除いて行と列の両方向の表を作る．
+  vector<std::pair<SizeType, SizeType>> pair_list;
+  pair_list.reserve(elem_list.size());
+  for ( auto& elem: elem_list ) {
+    pair_list.push_back({elem.row_pos, elem.col_pos});
+  }
+  std::sort(pair_list.begin(), pair_list.end());
+  pair_list.erase(std::unique(pair_list.begin(), pair_list.end()),
+		  pair_list.end());
+
+  mRowStart.assign(mRowSize + 1, 0);
+  mColStart.assign(mColSize + 1, 0);
+  for ( auto& p: pair_list ) {
+    ++ mRowStart[p.first + 1];
+    ++ mColStart[p.second + 1];
+  }
+  for ( SizeType row = 0; row < mRowSize; ++ row ) {
+    mRowStart[row + 1] += mRowStart[row];
+  }
+  for ( SizeType col = 0; col < mColSize; ++ col ) {
+    mColStart[col + 1] += mColStart[col];
+  }
+  mRowElem.resize(pair_list.size());
+  mColElem.resize(pair_list.size());
+  // pair_list は行番号の順に並んでいるので mColElem の各列も行番号の順になる．
+  vector<SizeType> col_pos{mColStart.begin(), mColStart.end() - 1};
+  SizeType pos = 0;
+  for ( auto& p: pair_list ) {
+    mRowElem[pos] = p.second;
+    ++ pos;
+    mColElem[col_pos[p.second]] = p.first;
+    ++ col_pos[p.second];
+  }
+
+  mRowMark.assign(mRowSize, 0);
+  mA1Mark.assign(mRowSize, 0);
+  mBMark.assign(mRowSize, 0);
+  mColMark.assign(mColSize, 0);
+}
+
+// @brief 解を改善する．
+SizeType
+LocalSearch::improve(
+  vector<SizeType>& solution
+)
+{
+  mStartTime = std::chrono::steady_clock::now();
+  mDeadline = mStartTime + std::chrono::milliseconds{mTimeLimit};
+  mInSol.assign(mColSize, false);
+  mCoverNum.assign(mRowSize, 0);
+  mSolList.clear();
+  for ( auto col: solution ) {
+    if ( col >= mColSize ) {
+      throw std::out_of_range{"col_pos is out of range"};
+    }
+    if ( !mInSol[col] ) {
+      add_col(col);
+      mSolList.push_back(col);
+    }
+  }
+  for ( SizeType row = 0; row < mRowSize; ++ row ) {
+    if ( mCoverNum[row] == 0 && row_begin(row) != row_end(row) ) {
+      throw std::invalid_argument{"solution is not a cover"};
+    }
+  }
+  mInitCost = 0;
+  for ( auto col: mSolList ) {
+    mInitCost += mCostArray[col];
+  }
+  mPassNum = 0;
+  mRemoveNum = 0;
+  mSwap1Num = 0;
+  mSwap2Num = 0;
+
+  mTmpList = mSolList;
+  remove_redundant(mTmpList);
+
+  // 以降は交換のたびに周りの冗長な列を取り除くので
+  // 各パスの開始時点では冗長な列はない．
+  vector<SizeType> order;
+  while ( (mSwap1 || mSwap2) && (mMaxPass == 0 || mPassNum < mMaxPass) ) {
+    ++ mPassNum;
+    order.clear();
+    ++ mEpoch;
+    for ( auto col: mSolList ) {
+      if ( mInSol[col] && mColMark[col] != mEpoch ) {
+	mColMark[col] = mEpoch;
+	order.push_back(col);
+      }
+    }
+    // コストの大きい列から置き換えを試みる．
+    std::stable_sort(order.begin(), order.end(),
+		     [&](SizeType a, SizeType b) {
+		       return mCostArray[a] > mCostArray[b];
+		     });
+    bool improved = false;
+    bool aborted = false;
+    for ( auto col: order ) {
+      if ( time_over() ) {
+	aborted = true;
+	break;
+      }
+      if ( !mInSol[col] ) {
+	continue;
+      }
+      if ( mSwap1 && try_swap1(col) ) {
+	improved = true;
+      }
+      else if ( mSwap2 && try_swap2(col) ) {
+	improved = true;
+      }
+    }
+    if ( !improved || aborted ) {
+      break;
+    }
+  }
+
+  // 結果を作る．
+  // mSolList には元の解の列が元の順番で，その後に加えた列が入っている．
+  ++ mEpoch;
+  solution.clear();
+  mFinalCost = 0;
+  for ( auto col: mSolList ) {
+    if ( mInSol[col] && mColMark[col] != mEpoch ) {
+      mColMark[col] = mEpoch;
+      solution.push_back(col);
+      mFinalCost += mCostArray[col];
+    }
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - mStartTime;
+  mTime = elapsed.count();
+
+  if ( mStats ) {
+    print_stats(cout);
+  }
+
+  return mFinalCost;
+}
+
+// @brief 統計情報を出力する．
+void
+LocalSearch::print_stats(
+  ostream& s
+) const
+{
+  s << "LocalSearch statistics: "
+    << "cost " << mInitCost << " -> " << mFinalCost << ", "
+    << mPassNum << " passes, "
+    << mTime << "(s)" << endl
+    << "  removed: " << mRemoveNum << ", "
+    << "1-for-1: " << mSwap1Num << ", "
+    << "2-for-1: " << mSwap2Num << endl;
+}
+
+// @brief 列を解に加える．
+void
+LocalSearch::add_col(
+  SizeType col
+)
+{
+  mInSol[col] = true;
+  for ( auto p = col_begin(col); p != col_end(col); ++ p ) {
+    ++ mCoverNum[*p];
+  }
+}
+
+// @brief 列を解から取り除く．
+void
+LocalSearch::remove_col(
+  SizeType col
+)
+{
+  mInSol[col] = false;
+  for ( auto p = col_begin(col); p != col_end(col); ++ p ) {
+    -- mCoverNum[*p];
+  }
+}
+
+// @brief 列が冗長な時 true を返す．
+bool
+LocalSearch::is_redundant(
+  SizeType col
+) const
+{
+  for ( auto p = col_begin(col); p != col_end(col); ++ p ) {
+    if ( mCoverNum[*p] == 1 ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// @brief 冗長な列をコストの大きい順に取り除く．
+void
+LocalSearch::remove_redundant(
+  vector<SizeType>& col_list
+)
+{
+  std::sort(col_list.begin(), col_list.end(),
+	    [&](SizeType a, SizeType b) {
+	      if ( mCostArray[a] != mCostArray[b] ) {
+		return mCostArray[a] > mCostArray[b];
+	      }
+	      return a < b;
+	    });
+  for ( auto col: col_list ) {
+    if ( mInSol[col] && is_redundant(col) ) {
+      remove_col(col);
+      ++ mRemoveNum;
+    }
+  }
+}
+
+// @brief col を含む行を持つ解の列を冗長なら取り除く．
+void
+LocalSearch::remove_redundant_around(
+  SizeType col
+)
+{
+  // 被覆数が増えたのは col の行だけなので，
+  // 新たに冗長になりうるのはそれらの行を持つ列だけ．
+  ++ mEpoch;
+  mTmpList.clear();
+  for ( auto p = col_begin(col); p != col_end(col); ++ p ) {
+    for ( auto q = row_begin(*p); q != row_end(*p); ++ q ) {
+      auto col1 = *q;
+      if ( col1 != col && mInSol[col1] && mColMark[col1] != mEpoch ) {
+	mColMark[col1] = mEpoch;
+	mTmpList.push_back(col1);
+      }
+    }
+  }
+  remove_redundant(mTmpList);
+}
+
+// @brief col だけが被覆している行に印をつける．
+SizeType
+LocalSearch::mark_unique_rows(
+  SizeType col
+)
+{
+  ++ mEpoch;
+  mUniqNum = 0;
+  SizeType min_row = mRowSize;
+  SizeType min_num = 0;
+  for ( auto p = col_begin(col); p != col_end(col); ++ p ) {
+    auto row = *p;
+    if ( mCoverNum[row] == 1 ) {
+      mRowMark[row] = mEpoch;
+      ++ mUniqNum;
+      SizeType num = mRowStart[row + 1] - mRowStart[row];
+      if ( min_row == mRowSize || min_num > num ) {
+	min_row = row;
+	min_num = num;
+      }
+    }
+  }
+  return min_row;
+}
+
+// @brief 1-for-1 交換を試す．
+bool
+LocalSearch::try_swap1(
+  SizeType col
+)
+{
+  auto row0 = mark_unique_rows(col);
+  if ( row0 == mRowSize ) {
+    // 冗長だった．
+    remove_col(col);
+    ++ mRemoveNum;
+    return true;
+  }
+  // 置き換える列は col だけが被覆している行をすべて被覆しなければならない．
+  // 候補は被覆する列の最も少ない row0 の列に限られる．
+  auto u_epoch = mEpoch;
+  SizeType best_col = mColSize;
+  SizeType best_cost = mCostArray[col];
+  for ( auto q = row_begin(row0); q != row_end(row0); ++ q ) {
+    auto col1 = *q;
+    if ( mInSol[col1] || mCostArray[col1] >= best_cost ) {
+      continue;
+    }
+    SizeType num = 0;
+    for ( auto p = col_begin(col1); p != col_end(col1); ++ p ) {
+      if ( mRowMark[*p] == u_epoch ) {
+	++ num;
+      }
+    }
+    if ( num == mUniqNum ) {
+      best_col = col1;
+      best_cost = mCostArray[col1];
+    }
+  }
+  if ( best_col == mColSize ) {
+    return false;
+  }
+
+  remove_col(col);
+  add_col(best_col);
+  mSolList.push_back(best_col);
+  ++ mSwap1Num;
+  remove_redundant_around(best_col);
+  return true;
+}
+
+// @brief 2-for-1 交換を試す．
+bool
+LocalSearch::try_swap2(
+  SizeType col
+)
+{
+  auto row0 = mark_unique_rows(col);
+  if ( row0 == mRowSize ) {
+    // 冗長だった．
+    remove_col(col);
+    ++ mRemoveNum;
+    return true;
+  }
+  auto u_epoch = mEpoch;
+  auto u_num = mUniqNum;
+  for ( auto p = col_begin(col); p != col_end(col); ++ p ) {
+    mA1Mark[*p] = u_epoch;
+  }
+
+  // col1 で col と col2 を置き換えられる条件は
+  // - col1 が col だけが被覆している行をすべて被覆する．
+  // - col と col2 を取り除くと被覆されなくなる col2 の行を col1 が被覆する．
+  // col2 は col1 と行を共有しているものに限られる．
+  std::int64_t cost0 = mCostArray[col];
+  std::int64_t best_gain = 0;
+  SizeType best_col1 = mColSize;
+  SizeType best_col2 = mColSize;
+  for ( auto q = row_begin(row0); q != row_end(row0); ++ q ) {
+    auto col1 = *q;
+    if ( mInSol[col1] ) {
+      continue;
+    }
+    SizeType num = 0;
+    for ( auto p = col_begin(col1); p != col_end(col1); ++ p ) {
+      if ( mRowMark[*p] == u_epoch ) {
+	++ num;
+      }
+    }
+    if ( num != u_num ) {
+      continue;
+    }
+    std::int64_t cost1 = mCostArray[col1];
+    ++ mEpoch;
+    auto b_epoch = mEpoch;
+    for ( auto p = col_begin(col1); p != col_end(col1); ++ p ) {
+      mBMark[*p] = b_epoch;
+    }
+    for ( auto p = col_begin(col1); p != col_end(col1); ++ p ) {
+      for ( auto q2 = row_begin(*p); q2 != row_end(*p); ++ q2 ) {
+	auto col2 = *q2;
+	if ( col2 == col || !mInSol[col2] || mColMark[col2] == b_epoch ) {
+	  continue;
+	}
+	mColMark[col2] = b_epoch;
+	std::int64_t gain = cost0 + mCostArray[col2] - cost1;
+	if ( gain <= best_gain ) {
+	  continue;
+	}
+	bool ok = true;
+	for ( auto p2 = col_begin(col2); p2 != col_end(col2); ++ p2 ) {
+	  auto row = *p2;
+	  SizeType rest = mCoverNum[row] - 1;
+	  if ( mA1Mark[row] == u_epoch ) {
+	    -- rest;
+	  }
+	  if ( rest == 0 && mBMark[row] != b_epoch ) {
+	    ok = false;
+	    break;
+	  }
+	}
+	if ( ok ) {
+	  best_gain = gain;
+	  best_col1 = col1;
+	  best_col2 = col2;
+	}
+      }
+    }
+  }
+  if ( best_col1 == mColSize ) {
+    return false;
+  }
+
+  remove_col(col);
+  remove_col(best_col2);
+  add_col(best_col1);
+  mSolList.push_back(best_col1);
+  ++ mSwap2Num;
+  remove_redundant_around(best_col1);
+  return true;
+}
+
+// @brief 制限時間を過ぎていたら true を返す．
+bool
+LocalSearch::time_over() const
+{
+  if ( mTimeLimit == 0 ) {
+    return false;
+  }
+  return std::chrono::steady_clock::now() >= mDeadline;
+}
+
+END_NAMESPACE_YM_MINCOV
@@ -0,0 +1,274 @@
+﻿#ifndef LOCALSEARCH_H
+#define LOCALSEARCH_H
+
+/// @file LocalSearch.h
+/// @brief LocalSearch のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/MinCov.h"
+#include "ym/JsonValue.h"
+#include <chrono>
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+/// @class LocalSearch LocalSearch.h "LocalSearch.h"
+/// @brief 被覆解を局所探索で改善するクラス
+///
+/// 縮約前の元の問題(行数，列のコスト，要素のリスト)を対象とするので，
+/// どの Solver の解にも適用できる．
+/// 行ごとに解の中でその行を被覆している列の数(被覆数)を持っておき，
+/// 以下の手順を改善がなくなるまで繰り返す．
+///
+/// * 冗長な列の削除: 被覆数が 1 の行を持たない列はコストの大きい順に取り除く．
+/// * 1-for-1 交換: 解の列 a を，a だけが被覆している行をすべて被覆する
+///   より安い列 b に置き換える．
+/// * 2-for-1 交換: 解の列 a1, a2 を，その2列を取り除くと被覆されなくなる
+///   行をすべて被覆する列 b に置き換える(cost(b) < cost(a1) + cost(a2))．
+///
+/// 被覆数を持っているので1つの交換の評価は関係する列の要素数に比例する時間で済む．
+///
+/// オプションには以下のキーを指定できる．
+/// - "swap1": false の時は 1-for-1 交換を行わない．
+/// - "swap2": false の時は 2-for-1 交換を行わない．
+/// - "max_pass": 解全体を調べる回数の上限(デフォルトは 0 で無制限)
+/// - "time_limit_ms": 制限時間(ミリ秒，0 なら無制限)
+/// - "stats": true の時は統計情報を出力する．
+//////////////////////////////////////////////////////////////////////
+class LocalSearch
+{
+public:
+
+  /// @brief コンストラクタ
+  LocalSearch(
+    SizeType row_size,                          ///< [in] 行数
+    const vector<SizeType>& col_cost_array,     ///< [in] 列のコスト配列
+    const vector<MinCov::ElemType>& elem_list,  ///< [in] 要素のリスト
+    const JsonValue& opt_obj                    ///< [in] オプションを表す JSON オブジェクト
+  );
+
+  /// @brief デストラクタ
+  ~LocalSearch() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 解を改善する．
+  /// @return 改善後の解のコスト
+  ///
+  /// solution は被覆解でなければならない．
+  /// 改善後も元の解に残った列は元の順番のままで，
+  /// 新たに加わった列はその後ろに並ぶ．
+  SizeType
+  improve(
+    vector<SizeType>& solution ///< [inout] 解のリスト
+  );
+
+  /// @brief 統計情報を出力する．
+  void
+  print_stats(
+    ostream& s ///< [in] 出力先のストリーム
+  ) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 列を解に加える．
+  void
+  add_col(
+    SizeType col
+  );
+
+  /// @brief 列を解から取り除く．
+  void
+  remove_col(
+    SizeType col
+  );
+
+  /// @brief 列が冗長な時 true を返す．
+  bool
+  is_redundant(
+    SizeType col
+  ) const;
+
+  /// @brief 冗長な列をコストの大きい順に取り除く．
+  ///
+  /// col_list の中の解に含まれる列だけを調べる．
+  void
+  remove_redundant(
+    vector<SizeType>& col_list
+  );
+
+  /// @brief col を含む行を持つ解の列を冗長なら取り除く．
+  void
+  remove_redundant_around(
+    SizeType col
+  );
+
+  /// @brief 1-for-1 交換を試す．
+  /// @return 交換した時 true を返す．
+  bool
+  try_swap1(
+    SizeType col
+  );
+
+  /// @brief 2-for-1 交換を試す．
+  /// @return 交換した時 true を返す．
+  bool
+  try_swap2(
+    SizeType col
+  );
+
+  /// @brief col だけが被覆している行に印をつける．
+  /// @return 印をつけた行のうちで被覆する列の最も少ない行を返す．
+  ///
+  /// そのような行がない時は mRowSize を返す．
+  /// 印をつけた行の数は mUniqNum に入る．
+  SizeType
+  mark_unique_rows(
+    SizeType col
+  );
+
+  /// @brief 制限時間を過ぎていたら true を返す．
+  bool
+  time_over() const;
+
+  /// @brief 行の要素(列番号)の先頭
+  const SizeType*
+  row_begin(
+    SizeType row
+  ) const
+  {
+    return &mRowElem[mRowStart[row]];
+  }
+
+  /// @brief 行の要素(列番号)の末尾
+  const SizeType*
+  row_end(
+    SizeType row
+  ) const
+  {
+    return &mRowElem[0] + mRowStart[row + 1];
+  }
+
+  /// @brief 列の要素(行番号)の先頭
+  const SizeType*
+  col_begin(
+    SizeType col
+  ) const
+  {
+    return &mColElem[mColStart[col]];
+  }
+
+  /// @brief 列の要素(行番号)の末尾
+  const SizeType*
+  col_end(
+    SizeType col
+  ) const
+  {
+    return &mColElem[0] + mColStart[col + 1];
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 行数
+  SizeType mRowSize;
+
+  // 列数
+  SizeType mColSize;
+
+  // 列のコスト配列
+  const vector<SizeType>& mCostArray;
+
+  // 行ごとの要素の開始位置(サイズは mRowSize + 1)
+  vector<SizeType> mRowStart;
+
+  // 行ごとの要素(列番号)
+  vector<SizeType> mRowElem;
+
+  // 列ごとの要素の開始位置(サイズは mColSize + 1)
+  vector<SizeType> mColStart;
+
+  // 列ごとの要素(行番号)
+  vector<SizeType> mColElem;
+
+  // 1-for-1 交換を行う時 true
+  bool mSwap1{true};
+
+  // 2-for-1 交換を行う時 true
+  bool mSwap2{true};
+
+  // 解全体を調べる回数の上限
+  SizeType mMaxPass{0};
+
+  // 制限時間(ミリ秒)
+  SizeType mTimeLimit{0};
+
+  // 統計情報を出力する時 true
+  bool mStats{false};
+
+  // 開始時刻
+  std::chrono::steady_clock::time_point mStartTime;
+
+  // 打ち切り時刻(mTimeLimit が 0 の時は意味を持たない)
+  std::chrono::steady_clock::time_point mDeadline;
+
+  // 列が解に含まれている時 true
+  vector<bool> mInSol;
+
+  // 行ごとの被覆数
+  vector<SizeType> mCoverNum;
+
+  // 解に含まれている列のリスト(取り除いた列も残っている)
+  vector<SizeType> mSolList;
+
+  // 行の印
+  vector<SizeType> mRowMark;
+
+  // 2-for-1 交換で取り除く列 a1 の行の印
+  vector<SizeType> mA1Mark;
+
+  // 2-for-1 交換で加える列 b の行の印
+  vector<SizeType> mBMark;
+
+  // 列の印
+  vector<SizeType> mColMark;
+
+  // 現在のエポック
+  // 印の配列は値がこれと等しい時に印がついているとみなす．
+  SizeType mEpoch{0};
+
+  // mark_unique_rows() で印をつけた行の数
+  SizeType mUniqNum{0};
+
+  // 作業用の列のリスト
+  vector<SizeType> mTmpList;
+
+  // 統計情報
+  SizeType mInitCost{0};
+  SizeType mFinalCost{0};
+  SizeType mPassNum{0};
+  SizeType mRemoveNum{0};
+  SizeType mSwap1Num{0};
+  SizeType mSwap2Num{0};
+  double mTime{0.0};
+
+};
+
+END_NAMESPACE_YM_MINCOV
+
+#endif // LOCALSEARCH_H
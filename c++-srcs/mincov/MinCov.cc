@@ -10,6 +10,7 @@
 #include "ym/JsonValue.h"
 #include "mincov/McMatrix.h"
 #include "Solver.h"
+#include "LocalSearch.h"
 #include "ym/Range.h"
 
 BEGIN_NAMESPACE_YM_MINCOV
@@ -22,12 +23,45 @@ BEGIN_NAMESPACE_YM_MINCOV
 SizeType
 MinCov::solve(
   vector<SizeType>& solution,
-  const JsonValue& option
+  const JsonValue& option,
+  Result& result
 )
 {
-  McMatrix matrix{row_size(), mColCostArray, mElemList};
+  // "compact": true の時はコンパクトモードの行列を用いる．
+  bool compact = false;
+  if ( option.has_key("compact") ) {
+    auto compact_val = option.at("compact");
+    if ( !compact_val.is_bool() ) {
+      throw std::invalid_argument{"compact should be boolean"};
+    }
+    compact = compact_val.get_bool();
+  }
+
+  // "improve" が指定されていたら局所探索で解を改善する．
+  // オプションの誤りで探索の結果を捨てないように先に作っておく．
+  std::unique_ptr<LocalSearch> ls;
+  if ( option.has_key("improve") ) {
+    auto improve_val = option.at("improve");
+    if ( !improve_val.is_bool() && !improve_val.is_object() ) {
+      throw std::invalid_argument{"improve should be boolean or a JSON object"};
+    }
+    if ( !improve_val.is_bool() || improve_val.get_bool() ) {
+      ls = std::unique_ptr<LocalSearch>{new LocalSearch{row_size(), mColCostArray,
+							mElemList, improve_val}};
+    }
+  }
+
+  McMatrix matrix{row_size(), mColCostArray, mElemList, compact};
   auto solver = Solver::new_obj(matrix, option);
   SizeType cost = solver->solve(solution);
+  if ( ls ) {
+    cost = ls->improve(solution);
+  }
+
+  result.cost = cost;
+  result.lower_bound = solver->lower_bound();
+  result.optimal = solver->is_optimal();
+  result.node_num = solver->node_num();
 
   { // 結果が正しいか検証しておく．
     vector<SizeType> uncov_row_list;
@@ -42,6 +76,29 @@ MinCov::solve(
   return cost;
 }
 
+// @brief 解を局所探索で改善する．
+SizeType
+MinCov::improve(
+  vector<SizeType>& solution
+)
+{
+  return improve(solution, JsonValue{});
+}
+
+// @brief 解を局所探索で改善する．
+SizeType
+MinCov::improve(
+  vector<SizeType>& solution,
+  const JsonValue& option
+)
+{
+  if ( !option.is_null() && !option.is_object() ) {
+    throw std::invalid_argument{"option should be a JSON object"};
+  }
+  LocalSearch ls{row_size(), mColCostArray, mElemList, option};
+  return ls.improve(solution);
+}
+
 #if 0
 // @brief 最小被覆問題を解く．
 SizeType
@@ -0,0 +1,371 @@
+﻿
+/// @file MultiStart.cc
+/// @brief MultiStart の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "MultiStart.h"
+#include "mincov/McMatrix.h"
+#include "mincov/McBlock.h"
+#include "mincov/Selector.h"
+#include <thread>
+#include <mutex>
+#include <cmath>
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+// クラス MultiStart
+//////////////////////////////////////////////////////////////////////
+
+// @brief コンストラクタ
+MultiStart::MultiStart(
+  McMatrix& matrix,
+  const JsonValue& opt_obj
+) : Solver{matrix, opt_obj},
+    mOptObj{opt_obj}
+{
+  auto start_num = get_int(opt_obj, "starts", 32);
+  if ( start_num <= 0 ) {
+    throw std::invalid_argument{"starts should be a positive integer"};
+  }
+  mStartNum = start_num;
+  auto thread_num = get_int(opt_obj, "threads", 1);
+  if ( thread_num <= 0 ) {
+    throw std::invalid_argument{"threads should be a positive integer"};
+  }
+  mThreadNum = thread_num;
+  auto seed = get_int(opt_obj, "seed", 1);
+  if ( seed < 0 ) {
+    throw std::invalid_argument{"seed should be a non-negative integer"};
+  }
+  mSeed = seed;
+  auto noise = get_int(opt_obj, "noise", 10);
+  if ( noise < 0 || noise > 100 ) {
+    throw std::invalid_argument{"noise should be an integer between 0 and 100"};
+  }
+  mNoise = noise / 100.0;
+  auto rcl = get_int(opt_obj, "rcl", 20);
+  if ( rcl < 0 || rcl > 100 ) {
+    throw std::invalid_argument{"rcl should be an integer between 0 and 100"};
+  }
+  mRcl = rcl / 100.0;
+  auto time_limit = get_int(opt_obj, "time_limit_ms", 0);
+  if ( time_limit < 0 ) {
+    throw std::invalid_argument{"time_limit_ms should be a non-negative integer"};
+  }
+  mTimeLimit = time_limit;
+  mStats = get_bool(opt_obj, "stats");
+
+  // オプションの誤りはここで検出しておく．
+  if ( !new_Selector(opt_obj)->has_score() ) {
+    throw std::invalid_argument{"multistart requires a selector with column scores"};
+  }
+}
+
+// @brief デストラクタ
+MultiStart::~MultiStart()
+{
+}
+
+// @brief 最小被覆問題を解く．
+SizeType
+MultiStart::solve(
+  vector<SizeType>& solution
+)
+{
+  auto start = std::chrono::steady_clock::now();
+  mDeadline = start + std::chrono::milliseconds{mTimeLimit};
+  mDoneNum = 0;
+  mResultList.clear();
+
+  if ( matrix().active_row_num() == 0 ) {
+    return matrix().cost(solution);
+  }
+
+  // 各スレッドはアクティブな部分だけからなる行列を持つ．
+  vector<SizeType> row_list;
+  row_list.reserve(matrix().active_row_num());
+  for ( auto row_pos: matrix().row_head_list() ) {
+    row_list.push_back(row_pos);
+  }
+  std::sort(row_list.begin(), row_list.end());
+  vector<SizeType> col_list;
+  col_list.reserve(matrix().active_col_num());
+  for ( auto col_pos: matrix().col_head_list() ) {
+    if ( matrix().col_elem_num(col_pos) > 0 ) {
+      col_list.push_back(col_pos);
+    }
+  }
+  std::sort(col_list.begin(), col_list.end());
+  McBlock block{std::move(row_list), std::move(col_list)};
+
+  std::atomic<SizeType> next_id{0};
+  std::mutex mutex;
+  SizeType best_cost = 0;
+  SizeType best_id = mStartNum;
+  vector<SizeType> best_solution;
+  std::exception_ptr error;
+
+  auto worker = [&]() {
+    try {
+      auto local_matrix = block.new_matrix(matrix());
+      auto selector = new_Selector(mOptObj);
+      vector<double> score_buf;
+      vector<SizeType> local_solution;
+      for ( ; ; ) {
+	SizeType id = next_id ++;
+	if ( id >= mStartNum || time_over() ) {
+	  break;
+	}
+	auto variant = id == 0 ? PLAIN : static_cast<Variant>(TIE + (id - 1) % 3);
+	std::seed_seq seq{static_cast<std::uint32_t>(mSeed),
+			  static_cast<std::uint32_t>(id)};
+	std::mt19937 rg{seq};
+	local_solution.clear();
+	if ( !run(*local_matrix, *selector, variant, rg,
+		  score_buf, local_solution) ) {
+	  break;
+	}
+	SizeType cost = local_matrix->cost(local_solution);
+	std::lock_guard<std::mutex> lock{mutex};
+	mResultList.push_back(RunResult{id, variant, cost});
+	if ( best_id == mStartNum || best_cost > cost ||
+	     (best_cost == cost && best_id > id) ) {
+	  best_cost = cost;
+	  best_id = id;
+	  best_solution = local_solution;
+	}
+	++ mDoneNum;
+      }
+    }
+    catch ( ... ) {
+      std::lock_guard<std::mutex> lock{mutex};
+      if ( !error ) {
+	error = std::current_exception();
+      }
+      // 他のスレッドも止める．
+      next_id = mStartNum;
+    }
+  };
+
+  SizeType n = std::min(mThreadNum, mStartNum);
+  vector<std::thread> thread_list;
+  thread_list.reserve(n - 1);
+  for ( SizeType i = 1; i < n; ++ i ) {
+    thread_list.push_back(std::thread{worker});
+  }
+  worker();
+  for ( auto& th: thread_list ) {
+    th.join();
+  }
+  if ( error ) {
+    std::rethrow_exception(error);
+  }
+  ASSERT_COND( best_id < mStartNum );
+
+  for ( auto col_id: best_solution ) {
+    solution.push_back(block.col_list()[col_id]);
+  }
+
+  if ( debug() || mStats ) {
+    std::chrono::duration<double> elapsed
+      = std::chrono::steady_clock::now() - start;
+    print_stats(cout, elapsed.count());
+  }
+
+  return matrix().cost(solution);
+}
+
+// @brief 1回分の Greedy を行う．
+bool
+MultiStart::run(
+  McMatrix& matrix,
+  Selector& selector,
+  Variant variant,
+  std::mt19937& rg,
+  vector<double>& score_buf,
+  vector<SizeType>& solution
+)
+{
+  bool done = true;
+  matrix.save();
+  while ( matrix.active_row_num() > 0 ) {
+    if ( time_over() ) {
+      done = false;
+      break;
+    }
+    auto col = choose_col(matrix, selector, variant, rg, score_buf);
+    matrix.select_col(col);
+    solution.push_back(col);
+
+    // Greedy と同様に行列を縮約する．
+    vector<SizeType> dummy;
+    matrix.reduce_loop(solution, dummy);
+  }
+  matrix.restore();
+  return done;
+}
+
+// @brief 次の列を選ぶ．
+SizeType
+MultiStart::choose_col(
+  const McMatrix& matrix,
+  Selector& selector,
+  Variant variant,
+  std::mt19937& rg,
+  vector<double>& score_buf
+)
+{
+  if ( variant == PLAIN ) {
+    return selector.select(matrix);
+  }
+
+  std::uniform_real_distribution<double> unit{0.0, 1.0};
+  double max_score = -DBL_MAX;
+  double min_score = DBL_MAX;
+  SizeType max_col = 0;
+  SizeType tie_num = 0;
+  if ( variant == RCL ) {
+    score_buf.resize(matrix.col_size());
+  }
+  for ( auto col_pos: matrix.col_head_list() ) {
+    double score = selector.score(matrix, col_pos);
+    switch ( variant ) {
+    case TIE:
+      // 最大値と等しい列の中から一様に選ぶ(reservoir sampling)．
+      if ( score > max_score * (1.0 + 1.0e-12) ) {
+	max_score = score;
+	max_col = col_pos;
+	tie_num = 1;
+      }
+      else if ( score >= max_score * (1.0 - 1.0e-12) ) {
+	++ tie_num;
+	if ( rg() % tie_num == 0 ) {
+	  max_col = col_pos;
+	}
+      }
+      break;
+
+    case NOISE:
+      score *= 1.0 + mNoise * (2.0 * unit(rg) - 1.0);
+      if ( max_score < score ) {
+	max_score = score;
+	max_col = col_pos;
+      }
+      break;
+
+    case RCL:
+      score_buf[col_pos] = score;
+      max_score = std::max(max_score, score);
+      min_score = std::min(min_score, score);
+      break;
+
+    default:
+      ASSERT_NOT_REACHED;
+    }
+  }
+  if ( variant != RCL ) {
+    return max_col;
+  }
+
+  // 閾値以上の列の中から一様に選ぶ．
+  // 要素が1つの行を持つ列は評価値が無限大になるので，
+  // その時は無限大の列だけを候補とする．
+  double threshold = max_score;
+  if ( !std::isinf(max_score) ) {
+    threshold -= mRcl * (max_score - min_score);
+  }
+  SizeType cand_num = 0;
+  for ( auto col_pos: matrix.col_head_list() ) {
+    if ( score_buf[col_pos] >= threshold ) {
+      ++ cand_num;
+    }
+  }
+  ASSERT_COND( cand_num > 0 );
+  SizeType k = rg() % cand_num;
+  for ( auto col_pos: matrix.col_head_list() ) {
+    if ( score_buf[col_pos] >= threshold ) {
+      if ( k == 0 ) {
+	return col_pos;
+      }
+      -- k;
+    }
+  }
+  ASSERT_NOT_REACHED;
+  return 0;
+}
+
+// @brief 制限時間を過ぎていたら true を返す．
+bool
+MultiStart::time_over() const
+{
+  return mTimeLimit > 0 && mDoneNum > 0 &&
+    std::chrono::steady_clock::now() >= mDeadline;
+}
+
+// @brief 解のコストの分布を出力する．
+void
+MultiStart::print_stats(
+  ostream& s,
+  double time
+) const
+{
+  auto print_line = [&](const char* name,
+			vector<SizeType> cost_list) {
+    if ( cost_list.empty() ) {
+      return;
+    }
+    std::sort(cost_list.begin(), cost_list.end());
+    double sum = 0.0;
+    for ( auto cost: cost_list ) {
+      sum += cost;
+    }
+    SizeType n = cost_list.size();
+    s << "  " << name << ": "
+      << n << " runs, "
+      << "min " << cost_list.front() << ", "
+      << "25% " << cost_list[n / 4] << ", "
+      << "median " << cost_list[n / 2] << ", "
+      << "75% " << cost_list[(3 * n) / 4] << ", "
+      << "max " << cost_list.back() << ", "
+      << "mean " << sum / n << endl;
+  };
+
+  s << "MultiStart statistics: "
+    << mResultList.size() << " / " << mStartNum << " runs, "
+    << time << "(s)" << endl;
+  vector<SizeType> all_list;
+  for ( auto variant: {PLAIN, TIE, NOISE, RCL} ) {
+    vector<SizeType> cost_list;
+    for ( auto& result: mResultList ) {
+      if ( result.variant == variant ) {
+	cost_list.push_back(result.cost);
+      }
+    }
+    print_line(variant_str(variant), cost_list);
+    all_list.insert(all_list.end(), cost_list.begin(), cost_list.end());
+  }
+  print_line("all", all_list);
+}
+
+// @brief 乱択の種類を表す文字列を返す．
+const char*
+MultiStart::variant_str(
+  Variant variant
+)
+{
+  switch ( variant ) {
+  case PLAIN: return "plain";
+  case TIE:   return "tie";
+  case NOISE: return "noise";
+  case RCL:   return "rcl";
+  }
+  ASSERT_NOT_REACHED;
+  return "";
+}
+
+END_NAMESPACE_YM_MINCOV
@@ -0,0 +1,186 @@
+﻿#ifndef MULTISTART_H
+#define MULTISTART_H
+
+/// @file MultiStart.h
+/// @brief MultiStart のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "Solver.h"
+#include "ym/JsonValue.h"
+#include <random>
+#include <atomic>
+#include <chrono>
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+/// @class MultiStart MultiStart.h "MultiStart.h"
+/// @brief 乱択を加えた Greedy を何度も行って最良の解を求めるクラス
+///
+/// "starts" 回(デフォルトは 32)の Greedy を行い，最もコストの小さい解を返す．
+/// 各回は自前の行列と乱数の種を持ち，"threads" 個のスレッドで並列に行う．
+/// 列の評価値は Selector::score() を用いるので，
+/// Selector は has_score() が true のもの("simple" か "naive")に限られる．
+///
+/// * 0 回目は乱択を行わない(Greedy と同じ解になる)．
+/// * 以降は以下の3通りの乱択を順番に用いる．
+///   - TIE: 評価値が最大の列が複数ある時にランダムに選ぶ．
+///   - NOISE: 評価値に ±"noise" % (デフォルトは 10)の一様な雑音を掛ける．
+///   - RCL: GRASP と同様に評価値が
+///     max - "rcl" % x (max - min) (デフォルトは 20 %)以上の列の中から
+///     ランダムに選ぶ．
+/// * 乱数の種は "seed" (デフォルトは 1)と回の番号から決まる．
+///   同じ回の結果はスレッド数によらない．
+///   最良の解が複数ある時は番号の小さい回のものを選ぶ．
+/// * "time_limit_ms" (0 なら無制限)を過ぎたら新しい回を始めず，
+///   実行中の回も打ち切る．ただし1つも解が得られていない時は続ける．
+/// * "stats" が true の時は最後に解のコストの分布を出力する．
+//////////////////////////////////////////////////////////////////////
+class MultiStart :
+  public Solver
+{
+public:
+
+  /// @brief コンストラクタ
+  MultiStart(
+    McMatrix& matrix,        ///< [in] 対象の行列
+    const JsonValue& opt_obj ///< [in] オプションを表す JSON オブジェクト
+  );
+
+  /// @brief デストラクタ
+  ~MultiStart();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 最小被覆問題を解く．
+  SizeType
+  solve(
+    vector<SizeType>& solution ///< [out] 選ばれた列集合
+  ) override;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる型
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 乱択の種類
+  enum Variant {
+    PLAIN, ///< 乱択なし
+    TIE,   ///< 評価値が等しい列からランダムに選ぶ．
+    NOISE, ///< 評価値に雑音を加える．
+    RCL    ///< 評価値の上位の列からランダムに選ぶ．
+  };
+
+  /// @brief 1回の結果
+  struct RunResult
+  {
+    SizeType id;      ///< 回の番号
+    Variant variant;  ///< 乱択の種類
+    SizeType cost;    ///< 解のコスト
+  };
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 1回分の Greedy を行う．
+  /// @retval true 解が得られた．
+  /// @retval false 制限時間を過ぎたので打ち切った．
+  ///
+  /// 行列は呼ぶ前の状態に戻される．
+  bool
+  run(
+    McMatrix& matrix,           ///< [in] 対象の行列
+    Selector& selector,         ///< [in] 列の評価値を求めるオブジェクト
+    Variant variant,            ///< [in] 乱択の種類
+    std::mt19937& rg,           ///< [in] 乱数発生器
+    vector<double>& score_buf,  ///< [in] 作業用の配列
+    vector<SizeType>& solution  ///< [out] 選ばれた列集合
+  );
+
+  /// @brief 次の列を選ぶ．
+  SizeType
+  choose_col(
+    const McMatrix& matrix,    ///< [in] 対象の行列
+    Selector& selector,        ///< [in] 列の評価値を求めるオブジェクト
+    Variant variant,           ///< [in] 乱択の種類
+    std::mt19937& rg,          ///< [in] 乱数発生器
+    vector<double>& score_buf  ///< [in] 作業用の配列
+  );
+
+  /// @brief 制限時間を過ぎていたら true を返す．
+  ///
+  /// 1つも解が得られていない時は false を返す．
+  bool
+  time_over() const;
+
+  /// @brief 解のコストの分布を出力する．
+  void
+  print_stats(
+    ostream& s,    ///< [in] 出力先のストリーム
+    double time    ///< [in] 経過時間(秒)
+  ) const;
+
+  /// @brief 乱択の種類を表す文字列を返す．
+  static
+  const char*
+  variant_str(
+    Variant variant ///< [in] 乱択の種類
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // オプションを表す JSON オブジェクト
+  // スレッドごとに Selector を作るのに用いる．
+  JsonValue mOptObj;
+
+  // Greedy を行う回数
+  SizeType mStartNum;
+
+  // スレッド数
+  SizeType mThreadNum;
+
+  // 乱数の種
+  SizeType mSeed;
+
+  // NOISE で用いる雑音の大きさ
+  double mNoise;
+
+  // RCL で用いる候補の範囲
+  double mRcl;
+
+  // 制限時間(ミリ秒)
+  SizeType mTimeLimit;
+
+  // 解のコストの分布を出力する時 true
+  bool mStats;
+
+  // 制限時間の時刻
+  std::chrono::steady_clock::time_point mDeadline;
+
+  // 解の得られた回数
+  std::atomic<SizeType> mDoneNum{0};
+
+  // 各回の結果のリスト
+  vector<RunResult> mResultList;
+
+};
+
+END_NAMESPACE_YM_MINCOV
+
+#endif // MULTISTART_H
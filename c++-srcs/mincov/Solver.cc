@@ -9,6 +9,7 @@
 #include "Solver.h"
 #include "Exact.h"
 #include "Greedy.h"
+#include "MultiStart.h"
 #include "mincov/McMatrix.h"
 #include "mincov/LbCalc.h"
 #include "mincov/Selector.h"
@@ -34,10 +35,7 @@ Solver::new_obj(
   const JsonValue& opt_obj
 )
 {
-  string algorithm{"greedy"};
-  if ( opt_obj.has_key("algorithm") ) {
-    algorithm = get_string(opt_obj["algorithm"], "algorithm");
-  }
+  auto algorithm = get_string(opt_obj, "algorithm", "greedy");
 
   if ( algorithm == "exact" ) {
     return unique_ptr<Solver>{new Exact{matrix, opt_obj}};
@@ -45,6 +43,9 @@ Solver::new_obj(
   if ( algorithm == "greedy" ) {
     return unique_ptr<Solver>{new Greedy{matrix, opt_obj}};
   }
+  if ( algorithm == "multistart" ) {
+    return unique_ptr<Solver>{new MultiStart{matrix, opt_obj}};
+  }
   {
     ostringstream buf;
     buf << algorithm << ": unknown algorithm";
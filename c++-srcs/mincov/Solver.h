@@ -60,6 +60,30 @@ public:
     vector<SizeType>& solution ///< [out] 選ばれた列集合
   ) = 0;
 
+  /// @brief 直前の solve() で最適性が証明されたか調べる．
+  virtual
+  bool
+  is_optimal() const
+  {
+    return false;
+  }
+
+  /// @brief 直前の solve() で得られた下界を返す．
+  virtual
+  SizeType
+  lower_bound() const
+  {
+    return 0;
+  }
+
+  /// @brief 直前の solve() で探索したノード数を返す．
+  virtual
+  SizeType
+  node_num() const
+  {
+    return 0;
+  }
+
 
 protected:
   //////////////////////////////////////////////////////////////////////
@@ -0,0 +1,243 @@
+
+/// @file LbCalc_test.cc
+/// @brief LbCalc_test の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "mincov/LbCalc.h"
+#include "mincov/McMatrix.h"
+#include "ym/JsonValue.h"
+#include <random>
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+BEGIN_NONAMESPACE
+
+using Dict = std::unordered_map<string, JsonValue>;
+
+// 全列挙で行列の最適解のコストを求める．
+int
+brute_force(
+  const McMatrix& matrix
+)
+{
+  vector<SizeType> col_list;
+  for ( auto col_pos: matrix.col_head_list() ) {
+    col_list.push_back(col_pos);
+  }
+  vector<SizeType> row_id(matrix.row_size(), 0);
+  SizeType nr = 0;
+  for ( auto row_pos: matrix.row_head_list() ) {
+    row_id[row_pos] = nr;
+    ++ nr;
+  }
+  SizeType nc = col_list.size();
+  vector<std::uint64_t> col_mask(nc, 0);
+  for ( SizeType i = 0; i < nc; ++ i ) {
+    for ( auto row_pos: matrix.col_elems(col_list[i]) ) {
+      col_mask[i] |= 1ULL << row_id[row_pos];
+    }
+  }
+  std::uint64_t all = nr == 64 ? ~0ULL : (1ULL << nr) - 1;
+  int best = INT_MAX;
+  for ( std::uint64_t b = 0; b < (1ULL << nc); ++ b ) {
+    std::uint64_t covered = 0;
+    int cost = 0;
+    for ( SizeType i = 0; i < nc; ++ i ) {
+      if ( (b >> i) & 1 ) {
+	covered |= col_mask[i];
+	cost += matrix.col_cost(col_list[i]);
+      }
+    }
+    if ( covered == all && best > cost ) {
+      best = cost;
+    }
+  }
+  return best;
+}
+
+// 下界のオプションを作る．
+JsonValue
+lb_option(
+  const char* type
+)
+{
+  return JsonValue{Dict{{"type", JsonValue{type}}}};
+}
+
+// どの下界も最適値を超えないことを確かめる．
+//
+// 1つのインスタンスで列の選択と削除を繰り返し，
+// 前回の結果を使い回す実装の更新も確かめる．
+void
+check_lower_bound(
+  const vector<JsonValue>& option_list,
+  std::uint32_t seed
+)
+{
+  std::mt19937 randgen(seed);
+  for ( SizeType t = 0; t < 40; ++ t ) {
+    SizeType nr = 4 + randgen() % 20;
+    SizeType nc = 3 + randgen() % 12;
+    std::uniform_int_distribution<SizeType> rd_col(0, nc - 1);
+    vector<SizeType> cost_array(nc, 1);
+    if ( t % 2 ) {
+      for ( auto& cost: cost_array ) {
+	cost = 1 + randgen() % 5;
+      }
+    }
+    vector<MinCov::ElemType> elem_list;
+    for ( SizeType row_pos = 0; row_pos < nr; ++ row_pos ) {
+      elem_list.push_back({row_pos, rd_col(randgen)});
+      for ( SizeType col_pos = 0; col_pos < nc; ++ col_pos ) {
+	if ( randgen() % 4 == 0 ) {
+	  elem_list.push_back({row_pos, col_pos});
+	}
+      }
+    }
+    for ( bool compact: {false, true} ) {
+      McMatrix matrix{nr, cost_array, elem_list, compact};
+      vector<unique_ptr<LbCalc>> lb_list;
+      for ( auto& option: option_list ) {
+	lb_list.push_back(LbCalc::new_obj(option));
+      }
+      for ( SizeType k = 0; k < 4; ++ k ) {
+	auto opt_cost = brute_force(matrix);
+	for ( SizeType i = 0; i < lb_list.size(); ++ i ) {
+	  auto lb = lb_list[i]->calc(matrix);
+	  EXPECT_LE( lb, opt_cost ) << "t = " << t << ", option#" << i;
+	  // 目標値を与えて打ち切った場合も下界になる．
+	  auto lb1 = lb_list[i]->calc(matrix, lb > 0 ? lb - 1 : 0);
+	  EXPECT_LE( lb1, opt_cost ) << "t = " << t << ", option#" << i;
+	}
+	// 列を1つ選んで縮約する．
+	if ( matrix.active_row_num() == 0 ) {
+	  break;
+	}
+	matrix.save();
+	vector<SizeType> col_list;
+	for ( auto col_pos: matrix.col_head_list() ) {
+	  col_list.push_back(col_pos);
+	}
+	matrix.select_col(col_list[randgen() % col_list.size()]);
+	if ( k % 2 ) {
+	  vector<SizeType> selected_cols;
+	  vector<SizeType> deleted_cols;
+	  matrix.reduce_loop(selected_cols, deleted_cols);
+	}
+      }
+    }
+  }
+}
+
+END_NONAMESPACE
+
+TEST(LbCalcTest, lagrange)
+{
+  check_lower_bound({
+      lb_option("LAGRANGE"),
+      JsonValue{Dict{{"type", JsonValue{"LAGRANGE"}}, {"max_iter", JsonValue{3}}}},
+      JsonValue{Dict{{"type", JsonValue{"LAGRANGE"}}, {"root_iter", JsonValue{0}},
+		     {"max_iter", JsonValue{0}}}},
+    }, 11);
+}
+
+TEST(LbCalcTest, dual)
+{
+  check_lower_bound({lb_option("DUAL")}, 13);
+}
+
+TEST(LbCalcTest, cs)
+{
+  check_lower_bound({lb_option("CS")}, 14);
+}
+
+TEST(LbCalcTest, mis)
+{
+  check_lower_bound({lb_option("MIS1"), lb_option("MIS2"), lb_option("MIS3")}, 15);
+}
+
+TEST(LbCalcTest, mis_weights)
+{
+  // 重みの種類が LbMIS2::MAX_CLASS_NUM を超える場合
+  // 列 i のコストは列番号とともに減っていき，行 i は列 i と
+  // それより前の列を含むので，行 i の重みは列 i のコストになる．
+  std::mt19937 randgen(16);
+  for ( SizeType t = 0; t < 6; ++ t ) {
+    SizeType nc = 17 + randgen() % 2;
+    SizeType nr = nc + randgen() % 6;
+    vector<SizeType> cost_array(nc);
+    for ( SizeType col_pos = 0; col_pos < nc; ++ col_pos ) {
+      cost_array[col_pos] = 3 * (nc - col_pos) + randgen() % 3;
+    }
+    vector<MinCov::ElemType> elem_list;
+    for ( SizeType row_pos = 0; row_pos < nr; ++ row_pos ) {
+      SizeType last = row_pos < nc ? row_pos : randgen() % nc;
+      elem_list.push_back({row_pos, last});
+      for ( SizeType col_pos = 0; col_pos < last; ++ col_pos ) {
+	if ( randgen() % 5 == 0 ) {
+	  elem_list.push_back({row_pos, col_pos});
+	}
+      }
+    }
+    McMatrix matrix{nr, cost_array, elem_list};
+    for ( auto type: {"MIS1", "MIS2"} ) {
+      auto lb_calc = LbCalc::new_obj(lb_option(type));
+      auto opt_cost = brute_force(matrix);
+      EXPECT_LE( lb_calc->calc(matrix), opt_cost ) << "t = " << t << ", " << type;
+      matrix.save();
+      matrix.select_col(nc - 1);
+      opt_cost = brute_force(matrix);
+      EXPECT_LE( lb_calc->calc(matrix), opt_cost ) << "t = " << t << ", " << type;
+      matrix.restore();
+    }
+  }
+}
+
+TEST(LbCalcTest, mis3)
+{
+  check_lower_bound({
+      JsonValue{Dict{{"type", JsonValue{"MIS3"}}, {"node_limit", JsonValue{2}}}},
+      JsonValue{Dict{{"type", JsonValue{"MIS3"}}, {"max_rows", JsonValue{8}}}},
+    }, 17);
+}
+
+TEST(LbCalcTest, max)
+{
+  vector<JsonValue> child_list{
+    lb_option("MIS2"),
+    JsonValue{Dict{{"type", JsonValue{"LAGRANGE"}}, {"max_iter", JsonValue{3}}}},
+    lb_option("DUAL")
+  };
+  check_lower_bound({
+      JsonValue{Dict{{"type", JsonValue{"MAX"}},
+		     {"child_list", JsonValue{child_list}}}},
+      JsonValue{Dict{{"type", JsonValue{"MAX"}},
+		     {"child_list", JsonValue{child_list}},
+		     {"parallel", JsonValue{true}}}},
+    }, 18);
+}
+
+TEST(LbCalcTest, bad_option)
+{
+  EXPECT_THROW( LbCalc::new_obj(JsonValue{Dict{{"type", JsonValue{"XXX"}}}}),
+		std::invalid_argument );
+  EXPECT_THROW( LbCalc::new_obj(JsonValue{Dict{{"type", JsonValue{"LAGRANGE"}},
+					       {"max_iter", JsonValue{-1}}}}),
+		std::invalid_argument );
+  EXPECT_THROW( LbCalc::new_obj(JsonValue{Dict{{"type", JsonValue{"MIS3"}},
+					       {"node_limit", JsonValue{-1}}}}),
+		std::invalid_argument );
+  EXPECT_THROW( LbCalc::new_obj(JsonValue{Dict{{"type", JsonValue{"MAX"}}}}),
+		std::invalid_argument );
+  EXPECT_THROW( LbCalc::new_obj(JsonValue{Dict{{"type", JsonValue{"MAX"}},
+					       {"child_list", JsonValue{vector<JsonValue>{}}},
+					       {"parallel", JsonValue{1}}}}),
+		std::invalid_argument );
+}
+
+END_NAMESPACE_YM_MINCOV
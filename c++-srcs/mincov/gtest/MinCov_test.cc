@@ -0,0 +1,620 @@
+
+/// @file MinCov_test.cc
+/// @brief MinCov_test の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include <gtest/gtest.h>
+#include "ym/MinCov.h"
+#include "ym/JsonValue.h"
+#include <random>
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+BEGIN_NONAMESPACE
+
+using Dict = std::unordered_map<string, JsonValue>;
+
+// 乱数で問題を作る．
+//
+// 要素を持たない行は作らない．
+// 同じ要素を重複して追加することもある．
+MinCov
+gen_problem(
+  std::mt19937& randgen,
+  SizeType nr,
+  SizeType nc,
+  double density,
+  bool weighted
+)
+{
+  std::uniform_real_distribution<double> rd_real(0.0, 1.0);
+  std::uniform_int_distribution<SizeType> rd_col(0, nc - 1);
+  std::uniform_int_distribution<SizeType> rd_cost(1, 5);
+  vector<SizeType> cost_array(nc, 1);
+  if ( weighted ) {
+    for ( auto& cost: cost_array ) {
+      cost = rd_cost(randgen);
+    }
+  }
+  MinCov mc{nr, cost_array};
+  for ( SizeType row_pos = 0; row_pos < nr; ++ row_pos ) {
+    mc.insert_elem(row_pos, rd_col(randgen));
+    for ( SizeType col_pos = 0; col_pos < nc; ++ col_pos ) {
+      if ( rd_real(randgen) < density ) {
+	mc.insert_elem(row_pos, col_pos);
+      }
+    }
+    if ( rd_real(randgen) < 0.2 ) {
+      mc.insert_elem(row_pos, rd_col(randgen));
+    }
+  }
+  return mc;
+}
+
+// 同じ行や列を複数含む問題を作る．
+MinCov
+gen_dup_problem(
+  std::mt19937& randgen,
+  SizeType nr,
+  SizeType nc,
+  double density
+)
+{
+  std::uniform_real_distribution<double> rd_real(0.0, 1.0);
+  std::uniform_int_distribution<SizeType> rd_col(0, nc - 1);
+  vector<SizeType> cost_array(nc * 2);
+  for ( SizeType col_pos = 0; col_pos < nc; ++ col_pos ) {
+    cost_array[col_pos] = 1 + col_pos % 3;
+    cost_array[col_pos + nc] = 1 + col_pos % 3;
+  }
+  MinCov mc{nr * 2, cost_array};
+  for ( SizeType row_pos = 0; row_pos < nr; ++ row_pos ) {
+    vector<SizeType> col_list{rd_col(randgen)};
+    for ( SizeType col_pos = 0; col_pos < nc; ++ col_pos ) {
+      if ( rd_real(randgen) < density ) {
+	col_list.push_back(col_pos);
+      }
+    }
+    // 行 row_pos と row_pos + nr，列 col_pos と col_pos + nc は同じものになる．
+    for ( auto col_pos: col_list ) {
+      for ( auto r: {row_pos, row_pos + nr} ) {
+	mc.insert_elem(r, col_pos);
+	mc.insert_elem(r, col_pos + nc);
+      }
+    }
+  }
+  return mc;
+}
+
+// 全列挙で最適解のコストを求める．
+SizeType
+brute_force(
+  const MinCov& mc
+)
+{
+  SizeType nc = mc.col_size();
+  vector<std::uint64_t> col_mask(nc, 0);
+  std::uint64_t all = 0;
+  for ( auto& elem: mc.elem_list() ) {
+    col_mask[elem.col_pos] |= 1ULL << elem.row_pos;
+    all |= 1ULL << elem.row_pos;
+  }
+  SizeType best = std::numeric_limits<SizeType>::max();
+  for ( std::uint64_t b = 0; b < (1ULL << nc); ++ b ) {
+    std::uint64_t covered = 0;
+    SizeType cost = 0;
+    for ( SizeType col_pos = 0; col_pos < nc; ++ col_pos ) {
+      if ( (b >> col_pos) & 1 ) {
+	covered |= col_mask[col_pos];
+	cost += mc.col_cost(col_pos);
+      }
+    }
+    if ( covered == all && best > cost ) {
+      best = cost;
+    }
+  }
+  return best;
+}
+
+// solution が被覆になっていたら true を返す．
+bool
+is_cover(
+  const MinCov& mc,
+  const vector<SizeType>& solution
+)
+{
+  vector<bool> selected(mc.col_size(), false);
+  for ( auto col_pos: solution ) {
+    selected[col_pos] = true;
+  }
+  vector<bool> covered(mc.row_size(), false);
+  for ( auto& elem: mc.elem_list() ) {
+    if ( selected[elem.col_pos] ) {
+      covered[elem.row_pos] = true;
+    }
+  }
+  for ( auto& elem: mc.elem_list() ) {
+    if ( !covered[elem.row_pos] ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// 解のコストを求める．
+SizeType
+solution_cost(
+  const MinCov& mc,
+  const vector<SizeType>& solution
+)
+{
+  SizeType cost = 0;
+  for ( auto col_pos: solution ) {
+    cost += mc.col_cost(col_pos);
+  }
+  return cost;
+}
+
+// 厳密解法のオプションを作る．
+JsonValue
+exact_option(
+  Dict dict
+)
+{
+  dict.emplace("algorithm", JsonValue{"exact"});
+  return JsonValue{dict};
+}
+
+// 下界のオプションを作る．
+JsonValue
+lb_option(
+  const char* type
+)
+{
+  return JsonValue{Dict{{"type", JsonValue{type}}}};
+}
+
+// "MAX" 型の下界のオプションを作る．
+JsonValue
+lb_max_option(
+  const vector<JsonValue>& child_list,
+  bool parallel
+)
+{
+  return JsonValue{Dict{{"type", JsonValue{"MAX"}},
+			{"child_list", JsonValue{child_list}},
+			{"parallel", JsonValue{parallel}}}};
+}
+
+// 乱数で作った問題をすべてのオプションで解いて，
+// 全列挙と同じコストになることを確かめる．
+void
+check_exact(
+  const vector<JsonValue>& option_list,
+  std::uint32_t seed
+)
+{
+  std::mt19937 randgen(seed);
+  for ( SizeType t = 0; t < 60; ++ t ) {
+    SizeType nr = 4 + randgen() % 18;
+    SizeType nc = 3 + randgen() % 12;
+    double density = 0.1 + 0.3 * (randgen() % 100) / 100.0;
+    auto mc = gen_problem(randgen, nr, nc, density, t % 2);
+    auto opt_cost = brute_force(mc);
+    for ( SizeType i = 0; i < option_list.size(); ++ i ) {
+      vector<SizeType> solution;
+      MinCov::Result result;
+      auto cost = mc.solve(solution, option_list[i], result);
+      ASSERT_TRUE( is_cover(mc, solution) ) << "t = " << t << ", option#" << i;
+      EXPECT_EQ( solution_cost(mc, solution), cost ) << "t = " << t << ", option#" << i;
+      EXPECT_EQ( opt_cost, cost ) << "t = " << t << ", option#" << i;
+      EXPECT_TRUE( result.optimal );
+      EXPECT_EQ( cost, result.cost );
+      EXPECT_EQ( cost, result.lower_bound );
+    }
+  }
+}
+
+END_NONAMESPACE
+
+TEST(MinCovTest, exact1)
+{
+  check_exact({
+      exact_option({}),
+      exact_option({{"compact", JsonValue{true}}}),
+      exact_option({{"partition", JsonValue{true}}}),
+      exact_option({{"partition", JsonValue{true}}, {"threads", JsonValue{3}}}),
+      exact_option({{"partition", JsonValue{true}}, {"compact", JsonValue{true}},
+		    {"threads", JsonValue{3}}}),
+    }, 1);
+}
+
+TEST(MinCovTest, exact_blocks)
+{
+  // 独立なブロックに分かれる問題
+  std::mt19937 randgen(5);
+  for ( SizeType t = 0; t < 60; ++ t ) {
+    SizeType nr = 0;
+    vector<SizeType> cost_array;
+    vector<MinCov::ElemType> elem_list;
+    for ( SizeType b = 0; b < 3; ++ b ) {
+      SizeType r = 2 + randgen() % 5;
+      SizeType c = 2 + randgen() % 5;
+      SizeType nc = cost_array.size();
+      for ( SizeType i = 0; i < r; ++ i ) {
+	elem_list.push_back({nr + i, nc + randgen() % c});
+	for ( SizeType j = 0; j < c; ++ j ) {
+	  if ( randgen() % 3 == 0 ) {
+	    elem_list.push_back({nr + i, nc + j});
+	  }
+	}
+      }
+      for ( SizeType j = 0; j < c; ++ j ) {
+	cost_array.push_back(1 + randgen() % 5);
+      }
+      nr += r;
+    }
+    MinCov mc{nr, cost_array};
+    for ( auto& elem: elem_list ) {
+      mc.insert_elem(elem.row_pos, elem.col_pos);
+    }
+    auto opt_cost = brute_force(mc);
+    for ( int th: {1, 3} ) {
+      auto option = exact_option({{"partition", JsonValue{true}},
+				  {"threads", JsonValue{th}}});
+      vector<SizeType> solution;
+      auto cost = mc.solve(solution, option);
+      ASSERT_TRUE( is_cover(mc, solution) );
+      EXPECT_EQ( opt_cost, cost ) << "t = " << t << ", threads = " << th;
+    }
+  }
+}
+
+TEST(MinCovTest, exact_mt)
+{
+  // ブロックに分けずに部分木を並列に探索する．
+  check_exact({
+      exact_option({{"threads", JsonValue{4}}}),
+      exact_option({{"threads", JsonValue{2}}, {"compact", JsonValue{true}}}),
+    }, 8);
+
+  std::mt19937 randgen(8);
+  auto mc = gen_problem(randgen, 10, 8, 0.3, false);
+  vector<SizeType> solution;
+  EXPECT_THROW( mc.solve(solution, exact_option({{"threads", JsonValue{0}}})),
+		std::invalid_argument );
+}
+
+TEST(MinCovTest, exact_mt_dup)
+{
+  // 同じ行や列を含む問題で並列探索が逐次探索と同じコストになる．
+  // 縮約で消える行や列が多いので，分岐の再現が崩れると結果が変わる．
+  // ビット演算の分枝限定法を使うと分岐しなくなるので用いない．
+  std::mt19937 randgen(8);
+  for ( SizeType t = 0; t < 10; ++ t ) {
+    auto mc = gen_dup_problem(randgen, 60 + randgen() % 20, 30 + randgen() % 10, 0.1);
+    vector<SizeType> solution1;
+    auto cost1 = mc.solve(solution1, exact_option({{"threads", JsonValue{1}},
+						       {"bit_kernel", JsonValue{0}}}));
+    ASSERT_TRUE( is_cover(mc, solution1) );
+    for ( bool partition: {false, true} ) {
+      auto option = exact_option({{"threads", JsonValue{4}},
+				  {"bit_kernel", JsonValue{0}},
+				  {"partition", JsonValue{partition}}});
+      vector<SizeType> solution4;
+      auto cost4 = mc.solve(solution4, option);
+      ASSERT_TRUE( is_cover(mc, solution4) );
+      EXPECT_EQ( solution_cost(mc, solution4), cost4 );
+      EXPECT_EQ( cost1, cost4 ) << "t = " << t << ", partition = " << partition;
+    }
+  }
+}
+
+TEST(MinCovTest, exact_primal)
+{
+  vector<JsonValue> sel_list{
+    JsonValue{Dict{}},
+    JsonValue{Dict{{"type", JsonValue{"naive"}}}}
+  };
+  check_exact({
+      exact_option({{"primal", JsonValue{false}}}),
+      exact_option({{"primal", JsonValue{Dict{{"interval", JsonValue{3}},
+					      {"selector", JsonValue{sel_list}}}}}}),
+      exact_option({{"primal", JsonValue{Dict{{"root", JsonValue{false}},
+					      {"interval", JsonValue{2}}}}},
+		    {"threads", JsonValue{3}}}),
+    }, 9);
+}
+
+TEST(MinCovTest, exact_limits)
+{
+  // 打ち切った時も被覆を返し，下界は最適値以下になる．
+  std::mt19937 randgen(21);
+  for ( SizeType t = 0; t < 4; ++ t ) {
+    auto mc = gen_problem(randgen, 80 + randgen() % 20, 40 + randgen() % 10, 0.08, t % 2);
+    vector<SizeType> solution0;
+    MinCov::Result result0;
+    auto opt_cost = mc.solve(solution0, exact_option({}), result0);
+    ASSERT_TRUE( result0.optimal );
+    EXPECT_EQ( opt_cost, result0.lower_bound );
+    EXPECT_EQ( 0, result0.gap() );
+    EXPECT_LT( 0, result0.node_num );
+    for ( int th: {1, 3} ) {
+      auto option = exact_option({{"node_limit", JsonValue{20}},
+				  {"threads", JsonValue{th}}});
+      vector<SizeType> solution;
+      MinCov::Result result;
+      auto cost = mc.solve(solution, option, result);
+      ASSERT_TRUE( is_cover(mc, solution) );
+      EXPECT_EQ( cost, result.cost );
+      EXPECT_LE( opt_cost, cost );
+      EXPECT_GE( opt_cost, result.lower_bound );
+      if ( result.optimal ) {
+	EXPECT_EQ( opt_cost, cost );
+      }
+    }
+    auto option = exact_option({{"time_limit_ms", JsonValue{1}}});
+    vector<SizeType> solution;
+    MinCov::Result result;
+    auto cost = mc.solve(solution, option, result);
+    ASSERT_TRUE( is_cover(mc, solution) );
+    EXPECT_LE( opt_cost, cost );
+    EXPECT_GE( opt_cost, result.lower_bound );
+  }
+}
+
+TEST(MinCovTest, exact_lagrange)
+{
+  check_exact({
+      exact_option({{"lower_bound", lb_option("LAGRANGE")}}),
+      exact_option({{"lower_bound", lb_option("LAGRANGE")}, {"threads", JsonValue{3}}}),
+      exact_option({{"lower_bound", JsonValue{Dict{{"type", JsonValue{"LAGRANGE"}},
+						   {"root_iter", JsonValue{5}},
+						   {"max_iter", JsonValue{1}}}}}}),
+    }, 11);
+}
+
+TEST(MinCovTest, exact_fixing)
+{
+  // 被約費用による列の固定の有無で結果が変わらない．
+  check_exact({
+      exact_option({{"fixing", JsonValue{false}},
+		    {"lower_bound", lb_option("LAGRANGE")}}),
+      exact_option({{"fixing", JsonValue{true}},
+		    {"lower_bound", lb_option("LAGRANGE")},
+		    {"partition", JsonValue{true}}}),
+    }, 12);
+}
+
+TEST(MinCovTest, exact_dual)
+{
+  check_exact({
+      exact_option({{"lower_bound", lb_option("DUAL")}}),
+      exact_option({{"lower_bound", lb_option("DUAL")}, {"threads", JsonValue{2}}}),
+    }, 13);
+}
+
+TEST(MinCovTest, exact_mis)
+{
+  // 衝突グラフを使い回す下界
+  check_exact({
+      exact_option({{"lower_bound", lb_option("MIS1")}}),
+      exact_option({{"lower_bound", lb_option("MIS2")}}),
+      exact_option({{"lower_bound", lb_option("MIS2")}, {"threads", JsonValue{2}}}),
+    }, 15);
+}
+
+TEST(MinCovTest, exact_mis3)
+{
+  check_exact({
+      exact_option({{"lower_bound", lb_option("MIS3")}}),
+      exact_option({{"lower_bound", lb_option("MIS3")}, {"partition", JsonValue{true}},
+		    {"threads", JsonValue{2}}}),
+    }, 17);
+}
+
+TEST(MinCovTest, exact_max)
+{
+  vector<JsonValue> lb_child_list{
+    lb_option("MIS2"),
+    JsonValue{Dict{{"type", JsonValue{"LAGRANGE"}}, {"max_iter", JsonValue{3}}}}
+  };
+  check_exact({
+      exact_option({{"lower_bound", lb_max_option(lb_child_list, false)},
+		    {"threads", JsonValue{2}}}),
+      exact_option({{"lower_bound", lb_max_option(lb_child_list, true)},
+		    {"partition", JsonValue{true}}}),
+    }, 18);
+
+  // 並列に計算する "MAX" は "threads" が 2 以上の時は使えない．
+  std::mt19937 randgen(5);
+  auto mc = gen_problem(randgen, 10, 8, 0.3, false);
+  auto lb_max_par = lb_max_option({lb_option("MIS2"), lb_option("DUAL")}, true);
+  vector<SizeType> solution;
+  EXPECT_THROW( mc.solve(solution, exact_option({{"lower_bound", lb_max_par},
+						 {"threads", JsonValue{2}}})),
+		std::invalid_argument );
+  // 入れ子になった "MAX" の中で指定した場合も同様
+  auto lb_nest = lb_max_option({lb_option("CS"), lb_max_par}, false);
+  EXPECT_THROW( mc.solve(solution, exact_option({{"lower_bound", lb_nest},
+						 {"threads", JsonValue{2}}})),
+		std::invalid_argument );
+}
+
+TEST(MinCovTest, exact_bit_kernel)
+{
+  check_exact({
+      exact_option({{"bit_kernel", JsonValue{0}}}),
+      exact_option({{"bit_kernel", JsonValue{8}}}),
+      exact_option({{"bit_kernel", JsonValue{5}}, {"threads", JsonValue{3}},
+		    {"partition", JsonValue{true}}}),
+    }, 19);
+}
+
+TEST(MinCovTest, exact_tt)
+{
+  check_exact({
+      exact_option({{"tt_size", JsonValue{1024}}, {"bit_kernel", JsonValue{0}}}),
+      exact_option({{"tt_size", JsonValue{16}}, {"partition", JsonValue{true}},
+		    {"bit_kernel", JsonValue{4}}, {"threads", JsonValue{2}}}),
+    }, 20);
+}
+
+TEST(MinCovTest, greedy_lazy)
+{
+  std::mt19937 randgen(21);
+  for ( SizeType t = 0; t < 100; ++ t ) {
+    SizeType nr = 4 + randgen() % 30;
+    SizeType nc = 3 + randgen() % 20;
+    double density = 0.05 + 0.3 * (randgen() % 100) / 100.0;
+    auto mc = gen_problem(randgen, nr, nc, density, t % 2);
+    for ( auto sel: {"simple", "naive"} ) {
+      auto option = JsonValue{Dict{{"algorithm", JsonValue{"greedy"}},
+				   {"lazy", JsonValue{true}},
+				   {"selector", JsonValue{Dict{{"type", JsonValue{sel}}}}}}};
+      vector<SizeType> solution;
+      auto cost = mc.solve(solution, option);
+      ASSERT_TRUE( is_cover(mc, solution) ) << "t = " << t << ", " << sel;
+      EXPECT_EQ( solution_cost(mc, solution), cost );
+      // 冗長な列は取り除かれている．
+      for ( SizeType i = 0; i < solution.size(); ++ i ) {
+	auto solution1 = solution;
+	solution1.erase(solution1.begin() + i);
+	EXPECT_FALSE( is_cover(mc, solution1) ) << "t = " << t << ", " << sel;
+      }
+    }
+  }
+  // lazy は "cs" を受け付けない．
+  auto mc = gen_problem(randgen, 5, 5, 0.3, false);
+  auto option = JsonValue{Dict{{"algorithm", JsonValue{"greedy"}},
+			       {"lazy", JsonValue{true}},
+			       {"selector", JsonValue{Dict{{"type", JsonValue{"cs"}}}}}}};
+  vector<SizeType> solution;
+  EXPECT_THROW( mc.solve(solution, option), std::invalid_argument );
+}
+
+TEST(MinCovTest, greedy1)
+{
+  std::mt19937 randgen(2);
+  for ( SizeType t = 0; t < 100; ++ t ) {
+    SizeType nr = 4 + randgen() % 30;
+    SizeType nc = 3 + randgen() % 20;
+    double density = 0.05 + 0.3 * (randgen() % 100) / 100.0;
+    auto mc = gen_problem(randgen, nr, nc, density, t % 2);
+    for ( auto sel: {"simple", "naive", "cs"} ) {
+      auto option = JsonValue{Dict{{"algorithm", JsonValue{"greedy"}},
+				   {"selector", JsonValue{Dict{{"type", JsonValue{sel}}}}}}};
+      vector<SizeType> solution;
+      auto cost = mc.solve(solution, option);
+      ASSERT_TRUE( is_cover(mc, solution) ) << "t = " << t << ", " << sel;
+      EXPECT_EQ( solution_cost(mc, solution), cost );
+    }
+  }
+}
+
+TEST(MinCovTest, exact_selector_cs)
+{
+  check_exact({
+      exact_option({{"selector", JsonValue{Dict{{"type", JsonValue{"cs"}}}}}}),
+    }, 23);
+}
+
+TEST(MinCovTest, multistart1)
+{
+  std::mt19937 randgen(24);
+  for ( SizeType t = 0; t < 60; ++ t ) {
+    SizeType nr = 4 + randgen() % 30;
+    SizeType nc = 3 + randgen() % 14;
+    double density = 0.05 + 0.3 * (randgen() % 100) / 100.0;
+    auto mc = gen_problem(randgen, nr, nc, density, t % 2);
+    vector<SizeType> greedy_solution;
+    auto greedy_cost = mc.solve(greedy_solution, JsonValue{Dict{{"algorithm", JsonValue{"greedy"}}}});
+    auto opt_cost = brute_force(mc);
+    vector<SizeType> solution1;
+    for ( int th: {1, 3} ) {
+      auto option = JsonValue{Dict{{"algorithm", JsonValue{"multistart"}},
+				   {"starts", JsonValue{10}},
+				   {"threads", JsonValue{th}},
+				   {"seed", JsonValue{static_cast<int>(t)}}}};
+      vector<SizeType> solution;
+      auto cost = mc.solve(solution, option);
+      ASSERT_TRUE( is_cover(mc, solution) ) << "t = " << t;
+      EXPECT_EQ( solution_cost(mc, solution), cost );
+      EXPECT_LE( cost, greedy_cost );
+      EXPECT_LE( opt_cost, cost );
+      // スレッド数によらず同じ解になる．
+      if ( th == 1 ) {
+	solution1 = solution;
+      }
+      else {
+	EXPECT_EQ( solution1, solution ) << "t = " << t;
+      }
+    }
+  }
+  auto mc = gen_problem(randgen, 5, 5, 0.3, false);
+  vector<SizeType> solution;
+  EXPECT_THROW( mc.solve(solution, JsonValue{Dict{{"algorithm", JsonValue{"multistart"}},
+						  {"starts", JsonValue{0}}}}),
+		std::invalid_argument );
+}
+
+TEST(MinCovTest, improve1)
+{
+  std::mt19937 randgen(25);
+  for ( SizeType t = 0; t < 100; ++ t ) {
+    SizeType nr = 4 + randgen() % 30;
+    SizeType nc = 3 + randgen() % 14;
+    double density = 0.05 + 0.3 * (randgen() % 100) / 100.0;
+    auto mc = gen_problem(randgen, nr, nc, density, t % 2);
+    auto opt_cost = brute_force(mc);
+
+    // 貪欲解に余計な列(重複を含む)を加えたものを改善する．
+    vector<SizeType> solution;
+    mc.solve(solution, JsonValue{Dict{{"algorithm", JsonValue{"greedy"}}}});
+    for ( SizeType k = 0; k < 5; ++ k ) {
+      solution.push_back(randgen() % nc);
+    }
+    auto cost0 = solution_cost(mc, solution);
+    auto cost = mc.improve(solution);
+    ASSERT_TRUE( is_cover(mc, solution) ) << "t = " << t;
+    EXPECT_EQ( solution_cost(mc, solution), cost );
+    EXPECT_GE( cost0, cost );
+    EXPECT_LE( opt_cost, cost );
+
+    // 改善済みの解はもう改善されない．
+    auto solution1 = solution;
+    EXPECT_EQ( cost, mc.improve(solution1) );
+
+    // 最適解を与えてもコストは上がらない．
+    vector<SizeType> opt_solution;
+    mc.solve(opt_solution, exact_option({}));
+    EXPECT_EQ( opt_cost, mc.improve(opt_solution) );
+    EXPECT_TRUE( is_cover(mc, opt_solution) );
+
+    // solve() から呼ぶ．
+    vector<SizeType> solution2;
+    auto option = JsonValue{Dict{{"algorithm", JsonValue{"greedy"}},
+				 {"improve", JsonValue{Dict{{"swap2", JsonValue{false}}}}}}};
+    auto cost2 = mc.solve(solution2, option);
+    ASSERT_TRUE( is_cover(mc, solution2) );
+    EXPECT_EQ( solution_cost(mc, solution2), cost2 );
+  }
+  // 被覆になっていない解は受け付けない．
+  auto mc = gen_problem(randgen, 6, 5, 0.3, false);
+  vector<SizeType> empty;
+  EXPECT_THROW( mc.improve(empty), std::invalid_argument );
+  // "improve" の誤りは解く前に検出される．
+  vector<SizeType> solution;
+  EXPECT_THROW( mc.solve(solution, exact_option({{"improve", JsonValue{3}}})),
+		std::invalid_argument );
+  EXPECT_THROW( mc.solve(solution, exact_option({{"improve",
+						  JsonValue{Dict{{"swap1", JsonValue{1}}}}}})),
+		std::invalid_argument );
+  EXPECT_TRUE( solution.empty() );
+}
+
+END_NAMESPACE_YM_MINCOV
@@ -0,0 +1,359 @@
+
+/// @file ConflictGraph.cc
+/// @brief ConflictGraph の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ConflictGraph.h"
+#include "mincov/McMatrix.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+// クラス ConflictGraph
+//////////////////////////////////////////////////////////////////////
+
+// @brief 行列の現在の状態に合わせて更新する．
+void
+ConflictGraph::update(
+  const McMatrix& matrix
+)
+{
+  // 別の行列の時や，内容が変わって登録が外れた時，
+  // 基本グラフにない行や列が復活した時は差分では表せないので作り直す．
+  if ( observed_matrix() != &matrix || mNeedBuild ) {
+    build(matrix);
+    return;
+  }
+
+  // 差分を反映する．
+  // 削除された後に復元された行や列もあるので現在の状態と比べる．
+  // 1つずつ反映しても共有数と次数の整合性は保たれるので順序は問わない．
+  for ( auto col_pos: mDirtyColList ) {
+    mColDirty[col_pos] = false;
+    bool active = !matrix.col_deleted(col_pos);
+    if ( active != mColActive[col_pos] ) {
+      if ( active ) {
+	restore_col(col_pos);
+      }
+      else {
+	delete_col(col_pos);
+      }
+    }
+  }
+  mDirtyColList.clear();
+  for ( auto row_pos: mDirtyRowList ) {
+    mRowDirty[row_pos] = false;
+    bool active = !matrix.row_deleted(row_pos);
+    if ( active != mRowActive[row_pos] ) {
+      if ( active ) {
+	restore_row(row_pos);
+      }
+      else {
+	delete_row(row_pos);
+      }
+    }
+  }
+  mDirtyRowList.clear();
+}
+
+// @brief 行が削除された時に呼ばれる関数
+void
+ConflictGraph::rows_deleted(
+  const vector<SizeType>& row_list
+)
+{
+  for ( auto row_pos: row_list ) {
+    add_dirty_row(row_pos);
+  }
+}
+
+// @brief 列が削除された時に呼ばれる関数
+void
+ConflictGraph::cols_deleted(
+  const vector<SizeType>& col_list
+)
+{
+  for ( auto col_pos: col_list ) {
+    add_dirty_col(col_pos);
+  }
+}
+
+// @brief 行が復元された時に呼ばれる関数
+void
+ConflictGraph::rows_restored(
+  const vector<SizeType>& row_list
+)
+{
+  for ( auto row_pos: row_list ) {
+    if ( !mRowBase[row_pos] ) {
+      mNeedBuild = true;
+    }
+    add_dirty_row(row_pos);
+  }
+}
+
+// @brief 列が復元された時に呼ばれる関数
+void
+ConflictGraph::cols_restored(
+  const vector<SizeType>& col_list
+)
+{
+  for ( auto col_pos: col_list ) {
+    if ( !mColBase[col_pos] ) {
+      mNeedBuild = true;
+    }
+    add_dirty_col(col_pos);
+  }
+}
+
+// @brief 基本グラフを作る．
+void
+ConflictGraph::build(
+  const McMatrix& matrix
+)
+{
+  ++ mBuildNum;
+  attach(matrix);
+  SizeType rs = matrix.row_size();
+  SizeType cs = matrix.col_size();
+  mDirtyRowList.clear();
+  mRowDirty.clear();
+  mRowDirty.resize(rs, false);
+  mDirtyColList.clear();
+  mColDirty.clear();
+  mColDirty.resize(cs, false);
+  mNeedBuild = false;
+
+  mRowBase.clear();
+  mRowBase.resize(rs, false);
+  mRowStart.clear();
+  mRowStart.resize(rs + 1, 0);
+  mRowCol.clear();
+  matrix.with_lists([&](const auto& lists) {
+    for ( SizeType row_pos = 0; row_pos < rs; ++ row_pos ) {
+      mRowStart[row_pos] = mRowCol.size();
+      if ( !matrix.row_deleted(row_pos) ) {
+	mRowBase[row_pos] = true;
+	for ( auto col_pos: lists.row_list(row_pos) ) {
+	  mRowCol.push_back(col_pos);
+	}
+      }
+    }
+  });
+  mRowStart[rs] = mRowCol.size();
+  mRowActive = mRowBase;
+
+  mColBase.clear();
+  mColBase.resize(cs, false);
+  mColStart.clear();
+  mColStart.resize(cs + 1, 0);
+  mColRow.clear();
+  matrix.with_lists([&](const auto& lists) {
+    for ( SizeType col_pos = 0; col_pos < cs; ++ col_pos ) {
+      mColStart[col_pos] = mColRow.size();
+      if ( !matrix.col_deleted(col_pos) ) {
+	mColBase[col_pos] = true;
+	for ( auto row_pos: lists.col_list(col_pos) ) {
+	  mColRow.push_back(row_pos);
+	}
+      }
+    }
+  });
+  mColStart[cs] = mColRow.size();
+  mColActive = mColBase;
+
+  // 共有する列の数を数えながら隣接リストを作る．
+  mAdjStart.clear();
+  mAdjStart.resize(rs + 1, 0);
+  mAdjRow.clear();
+  mShared.clear();
+  mDegree.clear();
+  mDegree.resize(rs, 0);
+  vector<SizeType> count(rs, 0);
+  vector<SizeType> row_list;
+  matrix.with_lists([&](const auto& lists) {
+    for ( SizeType row_pos = 0; row_pos < rs; ++ row_pos ) {
+      mAdjStart[row_pos] = mAdjRow.size();
+      if ( !mRowBase[row_pos] ) {
+	continue;
+      }
+      row_list.clear();
+      for ( auto col_pos: lists.row_list(row_pos) ) {
+	for ( auto row_pos2: lists.col_list(col_pos) ) {
+	  if ( row_pos2 == row_pos ) {
+	    continue;
+	  }
+	  if ( count[row_pos2] == 0 ) {
+	    row_list.push_back(row_pos2);
+	  }
+	  ++ count[row_pos2];
+	}
+      }
+      std::sort(row_list.begin(), row_list.end());
+      for ( auto row_pos2: row_list ) {
+	mAdjRow.push_back(row_pos2);
+	mShared.push_back(count[row_pos2]);
+	count[row_pos2] = 0;
+      }
+      mDegree[row_pos] = row_list.size();
+    }
+  });
+  mAdjStart[rs] = mAdjRow.size();
+
+  // 逆向きの枝を求める．
+  mRev.clear();
+  mRev.resize(mAdjRow.size());
+  for ( SizeType row_pos = 0; row_pos < rs; ++ row_pos ) {
+    for ( auto e = adj_begin(row_pos); e < adj_end(row_pos); ++ e ) {
+      auto row_pos2 = mAdjRow[e];
+      if ( row_pos < row_pos2 ) {
+	auto e2 = find_edge(row_pos2, row_pos);
+	mRev[e] = e2;
+	mRev[e2] = e;
+      }
+    }
+  }
+
+  mEdgeMap.clear();
+  mEdgeMap.resize(rs, 0);
+}
+
+// @brief 行を削除する．
+void
+ConflictGraph::delete_row(
+  SizeType row_pos
+)
+{
+  mRowActive[row_pos] = false;
+  for ( auto e = adj_begin(row_pos); e < adj_end(row_pos); ++ e ) {
+    if ( mShared[e] > 0 ) {
+      -- mDegree[mAdjRow[e]];
+      mShared[e] = 0;
+      mShared[mRev[e]] = 0;
+    }
+  }
+  mDegree[row_pos] = 0;
+}
+
+// @brief 行を復元する．
+void
+ConflictGraph::restore_row(
+  SizeType row_pos
+)
+{
+  // 共有数はすべて 0 になっているので
+  // アクティブな列のアクティブな行との共有数を数え直す．
+  mRowActive[row_pos] = true;
+  mDegree[row_pos] = 0;
+  for ( auto e = adj_begin(row_pos); e < adj_end(row_pos); ++ e ) {
+    mEdgeMap[mAdjRow[e]] = e;
+  }
+  for ( auto i = mRowStart[row_pos]; i < mRowStart[row_pos + 1]; ++ i ) {
+    auto col_pos = mRowCol[i];
+    if ( !mColActive[col_pos] ) {
+      continue;
+    }
+    for ( auto j = mColStart[col_pos]; j < mColStart[col_pos + 1]; ++ j ) {
+      auto row_pos2 = mColRow[j];
+      if ( row_pos2 != row_pos && mRowActive[row_pos2] ) {
+	inc_shared(mEdgeMap[row_pos2]);
+      }
+    }
+  }
+}
+
+// @brief 列を削除する．
+void
+ConflictGraph::delete_col(
+  SizeType col_pos
+)
+{
+  mColActive[col_pos] = false;
+  auto begin = mColStart[col_pos];
+  auto end = mColStart[col_pos + 1];
+  for ( auto i1 = begin; i1 < end; ++ i1 ) {
+    auto row_pos1 = mColRow[i1];
+    if ( !mRowActive[row_pos1] ) {
+      continue;
+    }
+    for ( auto i2 = i1 + 1; i2 < end; ++ i2 ) {
+      auto row_pos2 = mColRow[i2];
+      if ( mRowActive[row_pos2] ) {
+	dec_shared(find_edge(row_pos1, row_pos2));
+      }
+    }
+  }
+}
+
+// @brief 列を復元する．
+void
+ConflictGraph::restore_col(
+  SizeType col_pos
+)
+{
+  mColActive[col_pos] = true;
+  auto begin = mColStart[col_pos];
+  auto end = mColStart[col_pos + 1];
+  for ( auto i1 = begin; i1 < end; ++ i1 ) {
+    auto row_pos1 = mColRow[i1];
+    if ( !mRowActive[row_pos1] ) {
+      continue;
+    }
+    for ( auto i2 = i1 + 1; i2 < end; ++ i2 ) {
+      auto row_pos2 = mColRow[i2];
+      if ( mRowActive[row_pos2] ) {
+	inc_shared(find_edge(row_pos1, row_pos2));
+      }
+    }
+  }
+}
+
+// @brief 枝の共有数を1つ増やす．
+void
+ConflictGraph::inc_shared(
+  SizeType edge
+)
+{
+  auto rev = mRev[edge];
+  if ( mShared[edge] == 0 ) {
+    ++ mDegree[mAdjRow[edge]];
+    ++ mDegree[mAdjRow[rev]];
+  }
+  ++ mShared[edge];
+  ++ mShared[rev];
+}
+
+// @brief 枝の共有数を1つ減らす．
+void
+ConflictGraph::dec_shared(
+  SizeType edge
+)
+{
+  auto rev = mRev[edge];
+  -- mShared[edge];
+  -- mShared[rev];
+  if ( mShared[edge] == 0 ) {
+    -- mDegree[mAdjRow[edge]];
+    -- mDegree[mAdjRow[rev]];
+  }
+}
+
+// @brief 枝を探す．
+SizeType
+ConflictGraph::find_edge(
+  SizeType row_pos1,
+  SizeType row_pos2
+) const
+{
+  auto begin = mAdjRow.begin() + mAdjStart[row_pos1];
+  auto end = mAdjRow.begin() + mAdjStart[row_pos1 + 1];
+  auto p = std::lower_bound(begin, end, row_pos2);
+  ASSERT_COND( p != end && *p == row_pos2 );
+  return p - mAdjRow.begin();
+}
+
+END_NAMESPACE_YM_MINCOV
@@ -0,0 +1,301 @@
+#ifndef CONFLICTGRAPH_H
+#define CONFLICTGRAPH_H
+
+/// @file ConflictGraph.h
+/// @brief ConflictGraph のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "mincov/mincov_nsdef.h"
+#include "mincov/McObserver.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+/// @class ConflictGraph ConflictGraph.h "ConflictGraph.h"
+/// @brief 行の衝突グラフを表すクラス
+///
+/// アクティブな列を共有するアクティブな行どうしを隣接しているとみなす．
+/// MIS を用いた下界の計算で用いる．
+///
+/// * 最初の update() の時点でアクティブな行と列から「基本グラフ」を作る．
+///   隣接リストは行ごとにまとめた配列で表し，各枝には両端の行が共有している
+///   アクティブな列の数(共有数)を持たせる．
+///   どちらかの端の行がアクティブでない枝の共有数は 0 とする．
+/// * 以降の update() では前回からの行と列の削除/復元の差分だけを反映する．
+///   差分は McObserver として行列から通知された行と列だけを調べて求める．
+///   - 列の削除/復元ではその列のアクティブな行の対ごとに共有数を増減する．
+///   - 行の削除ではその行の枝の共有数を 0 にする．
+///   - 行の復元ではその行のアクティブな列のアクティブな行との共有数を増やす．
+///   共有数が 0 になった(0 でなくなった)枝の両端の次数を更新する．
+/// * 基本グラフに含まれない行や列が復活した時や，
+///   別の行列が与えられた時(登録が外れた時)は基本グラフを作り直す．
+//////////////////////////////////////////////////////////////////////
+class ConflictGraph :
+  public McObserver
+{
+public:
+
+  /// @brief コンストラクタ
+  ConflictGraph() = default;
+
+  /// @brief デストラクタ
+  ~ConflictGraph() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 行列の現在の状態に合わせて更新する．
+  void
+  update(
+    const McMatrix& matrix ///< [in] 対象の行列
+  );
+
+  /// @brief 行の次数を返す．
+  ///
+  /// row_pos はアクティブな行でなければならない．
+  SizeType
+  degree(
+    SizeType row_pos ///< [in] 行番号
+  ) const
+  {
+    return mDegree[row_pos];
+  }
+
+  /// @brief 行の隣接リストの先頭の枝番号を返す．
+  SizeType
+  adj_begin(
+    SizeType row_pos ///< [in] 行番号
+  ) const
+  {
+    return mAdjStart[row_pos];
+  }
+
+  /// @brief 行の隣接リストの末尾の次の枝番号を返す．
+  SizeType
+  adj_end(
+    SizeType row_pos ///< [in] 行番号
+  ) const
+  {
+    return mAdjStart[row_pos + 1];
+  }
+
+  /// @brief 枝の行き先の行番号を返す．
+  SizeType
+  adj_row(
+    SizeType edge ///< [in] 枝番号
+  ) const
+  {
+    return mAdjRow[edge];
+  }
+
+  /// @brief 枝が現在の行列で有効な時 true を返す．
+  ///
+  /// 両端の行がアクティブで，共有しているアクティブな列がある時に有効となる．
+  bool
+  is_valid(
+    SizeType edge ///< [in] 枝番号
+  ) const
+  {
+    return mShared[edge] > 0;
+  }
+
+  /// @brief 基本グラフを作った回数を返す．
+  SizeType
+  build_num() const
+  {
+    return mBuildNum;
+  }
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // McObserver の仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 行が削除された時に呼ばれる関数
+  void
+  rows_deleted(
+    const vector<SizeType>& row_list ///< [in] 削除された行番号のリスト
+  ) override;
+
+  /// @brief 列が削除された時に呼ばれる関数
+  void
+  cols_deleted(
+    const vector<SizeType>& col_list ///< [in] 削除された列番号のリスト
+  ) override;
+
+  /// @brief 行が復元された時に呼ばれる関数
+  void
+  rows_restored(
+    const vector<SizeType>& row_list ///< [in] 復元された行番号のリスト
+  ) override;
+
+  /// @brief 列が復元された時に呼ばれる関数
+  void
+  cols_restored(
+    const vector<SizeType>& col_list ///< [in] 復元された列番号のリスト
+  ) override;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 基本グラフを作る．
+  void
+  build(
+    const McMatrix& matrix ///< [in] 対象の行列
+  );
+
+  /// @brief 変化した行を記録する．
+  void
+  add_dirty_row(
+    SizeType row_pos ///< [in] 行番号
+  )
+  {
+    if ( !mRowDirty[row_pos] ) {
+      mRowDirty[row_pos] = true;
+      mDirtyRowList.push_back(row_pos);
+    }
+  }
+
+  /// @brief 変化した列を記録する．
+  void
+  add_dirty_col(
+    SizeType col_pos ///< [in] 列番号
+  )
+  {
+    if ( !mColDirty[col_pos] ) {
+      mColDirty[col_pos] = true;
+      mDirtyColList.push_back(col_pos);
+    }
+  }
+
+  /// @brief 行を削除する．
+  void
+  delete_row(
+    SizeType row_pos ///< [in] 行番号
+  );
+
+  /// @brief 行を復元する．
+  void
+  restore_row(
+    SizeType row_pos ///< [in] 行番号
+  );
+
+  /// @brief 列を削除する．
+  void
+  delete_col(
+    SizeType col_pos ///< [in] 列番号
+  );
+
+  /// @brief 列を復元する．
+  void
+  restore_col(
+    SizeType col_pos ///< [in] 列番号
+  );
+
+  /// @brief 枝の共有数を1つ増やす．
+  void
+  inc_shared(
+    SizeType edge ///< [in] 枝番号
+  );
+
+  /// @brief 枝の共有数を1つ減らす．
+  void
+  dec_shared(
+    SizeType edge ///< [in] 枝番号
+  );
+
+  /// @brief 枝を探す．
+  /// @return row_pos1 から row_pos2 への枝番号を返す．
+  SizeType
+  find_edge(
+    SizeType row_pos1, ///< [in] 行番号1
+    SizeType row_pos2  ///< [in] 行番号2
+  ) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 基本グラフに含まれる行の時 true
+  vector<bool> mRowBase;
+
+  // 基本グラフに含まれる列の時 true
+  vector<bool> mColBase;
+
+  // グラフ上でアクティブな行の時 true
+  vector<bool> mRowActive;
+
+  // グラフ上でアクティブな列の時 true
+  vector<bool> mColActive;
+
+  // 行ごとの列のリストの先頭位置
+  // サイズは行数 + 1
+  vector<SizeType> mRowStart;
+
+  // 行ごとの列のリストを連結したもの
+  vector<SizeType> mRowCol;
+
+  // 列ごとの行のリストの先頭位置
+  // サイズは列数 + 1
+  vector<SizeType> mColStart;
+
+  // 列ごとの行のリストを連結したもの
+  vector<SizeType> mColRow;
+
+  // 行ごとの隣接リストの先頭位置
+  // サイズは行数 + 1
+  vector<SizeType> mAdjStart;
+
+  // 行ごとの隣接リストを連結したもの
+  // 各行の中では行番号の昇順に並んでいる．
+  vector<SizeType> mAdjRow;
+
+  // 枝ごとの共有数
+  vector<SizeType> mShared;
+
+  // 枝ごとの逆向きの枝の番号
+  vector<SizeType> mRev;
+
+  // 行ごとの次数
+  vector<SizeType> mDegree;
+
+  // 行の復元で用いる作業用の配列
+  // 行番号をキーにして枝番号を持つ．
+  vector<SizeType> mEdgeMap;
+
+  // 前回の update() 以降に削除/復元された行のリスト
+  vector<SizeType> mDirtyRowList;
+
+  // 行ごとの mDirtyRowList に含まれている印
+  vector<bool> mRowDirty;
+
+  // 前回の update() 以降に削除/復元された列のリスト
+  vector<SizeType> mDirtyColList;
+
+  // 列ごとの mDirtyColList に含まれている印
+  vector<bool> mColDirty;
+
+  // 基本グラフを作り直す必要がある時 true
+  bool mNeedBuild{false};
+
+  // 基本グラフを作った回数
+  SizeType mBuildNum{0};
+
+};
+
+END_NAMESPACE_YM_MINCOV
+
+#endif // CONFLICTGRAPH_H
@@ -21,21 +21,38 @@ int
 LbCS::calc(
   const McMatrix& matrix
 )
+{
+  return calc(matrix, INT_MAX);
+}
+
+// @brief 目標値を指定して下界の計算をする
+int
+LbCS::calc(
+  const McMatrix& matrix,
+  int target
+)
 {
   double cost = 0.0;
-  for ( auto row_pos: matrix.row_head_list() ) {
-    double min_cost = DBL_MAX;
-    for ( auto col_pos: matrix.row_list(row_pos) ) {
-      double cost = matrix.col_cost(col_pos);
-      double col_num = matrix.col_elem_num(col_pos);
-      double col_cost = cost / col_num;
-      if ( min_cost > col_cost ) {
-	min_cost = col_cost;
+  matrix.with_lists([&](const auto& lists) {
+    for ( auto row_pos: matrix.row_head_list() ) {
+      double min_cost = DBL_MAX;
+      for ( auto col_pos: lists.row_list(row_pos) ) {
+	double cost = matrix.col_cost(col_pos);
+	double col_num = matrix.col_elem_num(col_pos);
+	double col_cost = cost / col_num;
+	if ( min_cost > col_cost ) {
+	  min_cost = col_cost;
+	}
+      }
+      cost += min_cost;
+      if ( cost >= target ) {
+	// 各行の値は非負なので途中までの和も下界になる．
+	break;
       }
     }
-    cost += min_cost;
-  }
-  cost = ceil(cost);
+  });
+  // 実数の和の丸め誤差で最適値を超えないように少し引いてから切り上げる．
+  cost = ceil(cost - 1e-6);
 
   return static_cast<int>(cost);
 }
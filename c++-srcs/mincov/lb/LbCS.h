@@ -31,6 +31,15 @@ public:
     const McMatrix& matrix
   ) override;
 
+  /// @brief 目標値を指定して下界の計算をする
+  ///
+  /// 途中までの和が target に達したら打ち切る．
+  int
+  calc(
+    const McMatrix& matrix,
+    int target
+  ) override;
+
 };
 
 END_NAMESPACE_YM_MINCOV
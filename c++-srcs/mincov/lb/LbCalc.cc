@@ -13,6 +13,8 @@
 #include "LbMIS2.h"
 #include "LbMIS3.h"
 #include "LbMAX.h"
+#include "LbLagrangian.h"
+#include "LbDual.h"
 
 
 BEGIN_NAMESPACE_YM_MINCOV
@@ -30,7 +32,10 @@ LbCalc::new_obj(
   string type_str{"CS"};
   if ( opt_obj.has_key("type") ) {
     auto type_obj = opt_obj.at("type");
-    type_str = opt_obj.get_string();
+    if ( !type_obj.is_string() ) {
+      throw std::invalid_argument{"lower_bound.type should be a string"};
+    }
+    type_str = type_obj.get_string();
   }
   if ( type_str == "CS" ) {
     return unique_ptr<LbCalc>{new LbCS};
@@ -41,8 +46,32 @@ LbCalc::new_obj(
   if ( type_str == "MIS2" ) {
     return unique_ptr<LbCalc>{new LbMIS2};
   }
+  // 非負の整数のパラメータを取り出す．
+  auto get_int = [&](const string& key, int default_val) -> SizeType {
+    if ( !opt_obj.has_key(key) ) {
+      return default_val;
+    }
+    auto val_obj = opt_obj.at(key);
+    if ( !val_obj.is_int() || val_obj.get_int() < 0 ) {
+      ostringstream buf;
+      buf << key << " should be a non-negative integer";
+      throw std::invalid_argument{buf.str()};
+    }
+    return val_obj.get_int();
+  };
   if ( type_str == "MIS3" ) {
-    return unique_ptr<LbCalc>{new LbMIS3};
+    auto node_limit = get_int("node_limit", 1000);
+    auto max_rows = get_int("max_rows", 1000);
+    return unique_ptr<LbCalc>{new LbMIS3{node_limit, max_rows}};
+  }
+  if ( type_str == "LAGRANGE" ) {
+    // 反復回数の指定
+    auto root_iter = get_int("root_iter", 100);
+    auto max_iter = get_int("max_iter", 10);
+    return unique_ptr<LbCalc>{new LbLagrangian{root_iter, max_iter}};
+  }
+  if ( type_str == "DUAL" ) {
+    return unique_ptr<LbCalc>{new LbDual};
   }
   if ( type_str == "MAX" ) {
     if ( !opt_obj.has_key("child_list") ) {
@@ -54,10 +83,27 @@ LbCalc::new_obj(
     }
     SizeType n = childs_obj.size();
     vector<unique_ptr<LbCalc>> child_list(n);
+    vector<string> name_list(n);
     for ( SizeType i = 0; i < n; ++ i ) {
-      child_list[i] = new_obj(childs_obj[i]);
+      auto child_obj = childs_obj[i];
+      child_list[i] = new_obj(child_obj);
+      // 統計情報の表示に用いる名前
+      name_list[i] = "CS";
+      if ( child_obj.has_key("type") ) {
+	name_list[i] = child_obj.at("type").get_string();
+      }
+    }
+    // 子供を並列に計算するかどうか
+    bool parallel = false;
+    if ( opt_obj.has_key("parallel") ) {
+      auto parallel_obj = opt_obj.at("parallel");
+      if ( !parallel_obj.is_bool() ) {
+	throw std::invalid_argument{"'parallel' should be a boolean"};
+      }
+      parallel = parallel_obj.get_bool();
     }
-    return unique_ptr<LbCalc>{new LbMAX{std::move(child_list)}};
+    return unique_ptr<LbCalc>{new LbMAX{std::move(child_list), name_list,
+					 parallel}};
   }
   {
     ostringstream buf;
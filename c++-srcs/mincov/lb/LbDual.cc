@@ -0,0 +1,136 @@
+
+/// @file LbDual.cc
+/// @brief LbDual の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "LbDual.h"
+#include "mincov/McMatrix.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+// クラス LbDual
+//////////////////////////////////////////////////////////////////////
+
+// @brief 下界の計算をする
+int
+LbDual::calc(
+  const McMatrix& matrix
+)
+{
+  return calc(matrix, INT_MAX);
+}
+
+// @brief 目標値を指定して下界の計算をする
+int
+LbDual::calc(
+  const McMatrix& matrix,
+  int target
+)
+{
+  if ( mDual.size() != matrix.row_size() ||
+       mSlack.size() != matrix.col_size() ) {
+    // 別の行列に対して呼ばれたので双対変数を初期化する．
+    mDual.clear();
+    mDual.resize(matrix.row_size(), -1.0);
+    mSlack.resize(matrix.col_size());
+  }
+
+  matrix.with_lists([&](const auto& lists) {
+    // 初めての行の双対変数は column splitting の値にする．
+    for ( auto row_pos: matrix.row_head_list() ) {
+      if ( mDual[row_pos] < 0.0 ) {
+	double min_cost = DBL_MAX;
+	for ( auto col_pos: lists.row_list(row_pos) ) {
+	  double cost = static_cast<double>(matrix.col_cost(col_pos))
+	    / matrix.col_elem_num(col_pos);
+	  if ( min_cost > cost ) {
+	    min_cost = cost;
+	  }
+	}
+	mDual[row_pos] = min_cost;
+      }
+    }
+
+    // 列の余裕を求める．
+    for ( auto col_pos: matrix.col_head_list() ) {
+      double slack = matrix.col_cost(col_pos);
+      for ( auto row_pos: lists.col_list(col_pos) ) {
+	slack -= mDual[row_pos];
+      }
+      mSlack[col_pos] = slack;
+    }
+
+    // 余裕が負の列は含まれる行の双対変数を下げて実行可能にする．
+    for ( auto col_pos: matrix.col_head_list() ) {
+      for ( auto row_pos: lists.col_list(col_pos) ) {
+	if ( mSlack[col_pos] >= 0.0 ) {
+	  break;
+	}
+	double delta = std::min(mDual[row_pos], -mSlack[col_pos]);
+	decrease(lists, row_pos, delta);
+      }
+    }
+
+    // 要素数の少ない行から順に，含まれる列の余裕の最小値だけ増やす．
+    // 要素数の少ない行ほど他の行の邪魔をしにくい．
+    // 途中の双対変数も実行可能解なので，値が target に達したら打ち切ってよい．
+    mRowList.clear();
+    mValue = 0.0;
+    for ( auto row_pos: matrix.row_head_list() ) {
+      mRowList.push_back(row_pos);
+      mValue += mDual[row_pos];
+    }
+    std::sort(mRowList.begin(), mRowList.end(),
+	      [&](SizeType a, SizeType b) {
+		return matrix.row_elem_num(a) < matrix.row_elem_num(b);
+	      });
+    for ( auto row_pos: mRowList ) {
+      if ( ceil(mValue - 1e-6) >= target || canceled() ) {
+	break;
+      }
+      double min_slack = DBL_MAX;
+      for ( auto col_pos: lists.row_list(row_pos) ) {
+	if ( min_slack > mSlack[col_pos] ) {
+	  min_slack = mSlack[col_pos];
+	}
+      }
+      if ( min_slack > 0.0 ) {
+	mDual[row_pos] += min_slack;
+	mValue += min_slack;
+	for ( auto col_pos: lists.row_list(row_pos) ) {
+	  mSlack[col_pos] -= min_slack;
+	}
+      }
+    }
+  });
+
+  // コストは整数なので切り上げてよい．
+  // 丸め誤差で切り上げすぎないように少し引いておく．
+  double lb = ceil(mValue - 1e-6);
+  if ( lb < 0.0 ) {
+    lb = 0.0;
+  }
+  return static_cast<int>(lb);
+}
+
+// @brief 行の双対変数を減らす．
+template<class Lists>
+void
+LbDual::decrease(
+  const Lists& lists,
+  SizeType row_pos,
+  double delta
+)
+{
+  mDual[row_pos] -= delta;
+  for ( auto col_pos: lists.row_list(row_pos) ) {
+    mSlack[col_pos] += delta;
+  }
+}
+
+END_NAMESPACE_YM_MINCOV
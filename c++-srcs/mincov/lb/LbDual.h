@@ -0,0 +1,116 @@
+#ifndef LBDUAL_H
+#define LBDUAL_H
+
+/// @file LbDual.h
+/// @brief LbDual のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "mincov/LbCalc.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+/// @class LbDual LbDual.h "LbDual.h"
+/// @brief 双対上昇法を用いた下界の計算クラス
+///
+/// 被覆問題の LP 緩和の双対問題
+/// max Σ_i y_i s.t. Σ_{i in col j} y_i <= c_j, y_i >= 0
+/// の実行可能解を求めると Σ_i y_i が下界となる．
+///
+/// * 行の双対変数 y_i は column splitting(LbCS) の値から始めて，
+///   各列の余裕(被約費用)が負にならない範囲で貪欲に増やす．
+/// * 双対変数は行番号ごとに保持しておき，次の calc() で再利用する．
+///   削除された行の値はそのまま残り，行が復活した時に再び用いられる．
+///   前回から行が増えて実行不能になった列は，その列の行の値を下げて修正する．
+/// * 列の余裕を reduced_cost() で得られる．
+//////////////////////////////////////////////////////////////////////
+class LbDual :
+  public LbCalc
+{
+public:
+
+  /// @brief コンストラクタ
+  LbDual() = default;
+
+  /// @brief デストラクタ
+  ~LbDual() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 下界の計算をする
+  int
+  calc(
+    const McMatrix& matrix
+  ) override;
+
+  /// @brief 目標値を指定して下界の計算をする
+  int
+  calc(
+    const McMatrix& matrix,
+    int target
+  ) override;
+
+  /// @brief 直前の calc() で求めた列の被約費用を返す．
+  const vector<double>*
+  reduced_cost() const override
+  {
+    return &mSlack;
+  }
+
+  /// @brief 直前の calc() で求めた緩和問題の値を返す．
+  double
+  relaxed_value() const override
+  {
+    return mValue;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 行の双対変数を減らす．
+  ///
+  /// 行を含む列の余裕も更新する．
+  /// Lists は McMatrix::with_lists() が渡すもの
+  template<class Lists>
+  void
+  decrease(
+    const Lists& lists, ///< [in] 行列のリストの取り出し方
+    SizeType row_pos,   ///< [in] 行番号
+    double delta        ///< [in] 減らす量
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 行ごとの双対変数
+  // 負の値は未初期化を表す．
+  vector<double> mDual;
+
+  // 列ごとの余裕(被約費用)
+  vector<double> mSlack;
+
+  // 双対問題の値
+  double mValue{0.0};
+
+  // 作業用の行のリスト
+  vector<SizeType> mRowList;
+
+};
+
+END_NAMESPACE_YM_MINCOV
+
+#endif // LBDUAL_H
@@ -0,0 +1,185 @@
+
+/// @file LbLagrangian.cc
+/// @brief LbLagrangian の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "LbLagrangian.h"
+#include "mincov/McMatrix.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+// クラス LbLagrangian
+//////////////////////////////////////////////////////////////////////
+
+// @brief 下界の計算をする
+int
+LbLagrangian::calc(
+  const McMatrix& matrix
+)
+{
+  return calc(matrix, INT_MAX);
+}
+
+// @brief 目標値を指定して下界の計算をする
+int
+LbLagrangian::calc(
+  const McMatrix& matrix,
+  int target
+)
+{
+  SizeType iter_num = mMaxIter;
+  if ( mMult.size() != matrix.row_size() ||
+       mReducedCost.size() != matrix.col_size() ) {
+    // 別の行列に対して呼ばれたので乗数を初期化する．
+    mMult.clear();
+    mMult.resize(matrix.row_size(), -1.0);
+    mReducedCost.resize(matrix.col_size());
+    mTmpCost.resize(matrix.col_size());
+    mBestMult.resize(matrix.row_size());
+    mSubgrad.resize(matrix.row_size());
+    iter_num = mRootIter;
+  }
+
+  if ( matrix.active_row_num() == 0 ) {
+    mValue = 0.0;
+    for ( auto col_pos: matrix.col_head_list() ) {
+      mReducedCost[col_pos] = matrix.col_cost(col_pos);
+    }
+    return 0;
+  }
+
+  // 初めての行の乗数は column splitting の値にする．
+  matrix.with_lists([&](const auto& lists) {
+    for ( auto row_pos: matrix.row_head_list() ) {
+      if ( mMult[row_pos] < 0.0 ) {
+	double min_cost = DBL_MAX;
+	for ( auto col_pos: lists.row_list(row_pos) ) {
+	  double cost = static_cast<double>(matrix.col_cost(col_pos))
+	    / matrix.col_elem_num(col_pos);
+	  if ( min_cost > cost ) {
+	    min_cost = cost;
+	  }
+	}
+	mMult[row_pos] = min_cost;
+      }
+    }
+  });
+
+  // rc には現在の乗数 mMult に対する被約費用が入っている．
+  vector<double>& rc = mTmpCost;
+  double cur_value = eval(matrix, rc);
+  mValue = cur_value;
+  for ( auto row_pos: matrix.row_head_list() ) {
+    mBestMult[row_pos] = mMult[row_pos];
+  }
+  for ( auto col_pos: matrix.col_head_list() ) {
+    mReducedCost[col_pos] = rc[col_pos];
+  }
+
+  // 劣勾配法
+  // ステップ幅は Polyak のもので，目標値は最良値より少し大きくとる．
+  // 改善しない反復が続いたら係数を半分にする．
+  double lambda = 2.0;
+  SizeType no_improve = 0;
+  for ( SizeType iter = 0; iter < iter_num; ++ iter ) {
+    if ( ceil(mValue - 1e-6) >= target || canceled() ) {
+      // 目標値に達したので打ち切る．
+      break;
+    }
+
+    // 劣勾配 s_i = 1 - (被約費用が負の列のうち行 i を含むものの数)
+    // 乗数が 0 で s_i が負の行は動かさない．
+    double norm = 0.0;
+    matrix.with_lists([&](const auto& lists) {
+      for ( auto row_pos: matrix.row_head_list() ) {
+	double s = 1.0;
+	for ( auto col_pos: lists.row_list(row_pos) ) {
+	  if ( rc[col_pos] < 0.0 ) {
+	    s -= 1.0;
+	  }
+	}
+	if ( s < 0.0 && mMult[row_pos] <= 0.0 ) {
+	  s = 0.0;
+	}
+	mSubgrad[row_pos] = s;
+	norm += s * s;
+      }
+    });
+    if ( norm == 0.0 ) {
+      // 緩和問題の解が元の問題の最適解になっている．
+      break;
+    }
+
+    double step_target = mValue + std::max(1.0, std::abs(mValue) * 0.05);
+    double step = lambda * (step_target - cur_value) / norm;
+    for ( auto row_pos: matrix.row_head_list() ) {
+      double u = mMult[row_pos] + step * mSubgrad[row_pos];
+      mMult[row_pos] = u > 0.0 ? u : 0.0;
+    }
+
+    cur_value = eval(matrix, rc);
+    if ( cur_value > mValue + 1e-9 ) {
+      mValue = cur_value;
+      for ( auto row_pos: matrix.row_head_list() ) {
+	mBestMult[row_pos] = mMult[row_pos];
+      }
+      for ( auto col_pos: matrix.col_head_list() ) {
+	mReducedCost[col_pos] = rc[col_pos];
+      }
+      no_improve = 0;
+    }
+    else {
+      ++ no_improve;
+      if ( no_improve >= 5 ) {
+	lambda *= 0.5;
+	no_improve = 0;
+      }
+    }
+  }
+
+  // 次回は最良の乗数から始める．
+  for ( auto row_pos: matrix.row_head_list() ) {
+    mMult[row_pos] = mBestMult[row_pos];
+  }
+
+  // コストは整数なので切り上げてよい．
+  // 丸め誤差で切り上げすぎないように少し引いておく．
+  double lb = ceil(mValue - 1e-6);
+  if ( lb < 0.0 ) {
+    lb = 0.0;
+  }
+  return static_cast<int>(lb);
+}
+
+// @brief 乗数 mMult に対する緩和問題の値と被約費用を求める．
+double
+LbLagrangian::eval(
+  const McMatrix& matrix,
+  vector<double>& reduced_cost
+) const
+{
+  double value = 0.0;
+  for ( auto row_pos: matrix.row_head_list() ) {
+    value += mMult[row_pos];
+  }
+  matrix.with_lists([&](const auto& lists) {
+    for ( auto col_pos: matrix.col_head_list() ) {
+      double rc = matrix.col_cost(col_pos);
+      for ( auto row_pos: lists.col_list(col_pos) ) {
+	rc -= mMult[row_pos];
+      }
+      reduced_cost[col_pos] = rc;
+      if ( rc < 0.0 ) {
+	value += rc;
+      }
+    }
+  });
+  return value;
+}
+
+END_NAMESPACE_YM_MINCOV
@@ -0,0 +1,129 @@
+#ifndef LBLAGRANGIAN_H
+#define LBLAGRANGIAN_H
+
+/// @file LbLagrangian.h
+/// @brief LbLagrangian のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "mincov/LbCalc.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+/// @class LbLagrangian LbLagrangian.h "LbLagrangian.h"
+/// @brief ラグランジュ緩和を用いた下界の計算クラス
+///
+/// 各行の被覆条件に乗数 u_i >= 0 をかけて緩和すると
+/// L(u) = Σ_i u_i + Σ_j min(0, c_j - Σ_{i in col j} u_i)
+/// が下界となる．u を劣勾配法で改善する．
+///
+/// * 乗数は行番号ごとに保持しておき，次の calc() の初期値に用いる．
+///   分枝限定法では直前に計算したノードが近いので少ない反復で済む．
+/// * 初めての行の乗数は column splitting(LbCS) と同じ値で初期化するので，
+///   初回の下界は LbCS 以上になる．
+/// * 最良の乗数に対する列の被約費用を reduced_cost() で得られる．
+//////////////////////////////////////////////////////////////////////
+class LbLagrangian :
+  public LbCalc
+{
+public:
+
+  /// @brief コンストラクタ
+  LbLagrangian(
+    SizeType root_iter, ///< [in] 初回の劣勾配法の反復回数
+    SizeType max_iter   ///< [in] 2回目以降の劣勾配法の反復回数
+  ) : mRootIter{root_iter},
+      mMaxIter{max_iter}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~LbLagrangian() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 下界の計算をする
+  int
+  calc(
+    const McMatrix& matrix
+  ) override;
+
+  /// @brief 目標値を指定して下界の計算をする
+  int
+  calc(
+    const McMatrix& matrix,
+    int target
+  ) override;
+
+  /// @brief 直前の calc() で求めた列の被約費用を返す．
+  const vector<double>*
+  reduced_cost() const override
+  {
+    return &mReducedCost;
+  }
+
+  /// @brief 直前の calc() で求めた緩和問題の値を返す．
+  double
+  relaxed_value() const override
+  {
+    return mValue;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 乗数 mMult に対する緩和問題の値と被約費用を求める．
+  /// @return 緩和問題の値を返す．
+  double
+  eval(
+    const McMatrix& matrix,      ///< [in] 対象の行列
+    vector<double>& reduced_cost ///< [out] 列の被約費用
+  ) const;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 初回の反復回数
+  SizeType mRootIter;
+
+  // 2回目以降の反復回数
+  SizeType mMaxIter;
+
+  // 行ごとの乗数
+  // 負の値は未初期化を表す．
+  vector<double> mMult;
+
+  // 最良の乗数に対する列の被約費用
+  vector<double> mReducedCost;
+
+  // 最良の緩和問題の値
+  double mValue{0.0};
+
+  // 作業用の被約費用
+  vector<double> mTmpCost;
+
+  // 最良の乗数
+  vector<double> mBestMult;
+
+  // 作業用の劣勾配
+  vector<double> mSubgrad;
+
+};
+
+END_NAMESPACE_YM_MINCOV
+
+#endif // LBLAGRANGIAN_H
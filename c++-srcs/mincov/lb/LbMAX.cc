@@ -7,6 +7,7 @@
 /// All rights reserved.
 
 #include "LbMAX.h"
+#include <chrono>
 
 
 BEGIN_NAMESPACE_YM_MINCOV
@@ -15,20 +16,305 @@ BEGIN_NAMESPACE_YM_MINCOV
 // クラス LbMAX
 //////////////////////////////////////////////////////////////////////
 
+// @brief コンストラクタ
+LbMAX::LbMAX(
+  vector<unique_ptr<LbCalc>>&& child_list,
+  const vector<string>& name_list,
+  bool parallel
+) : mChildList{std::move(child_list)},
+    mStatsList(mChildList.size()),
+    mOrder(mChildList.size()),
+    mParallel{parallel && mChildList.size() > 1},
+    mValList(mChildList.size(), 0)
+{
+  ASSERT_COND( name_list.size() == mChildList.size() );
+  for ( SizeType i = 0; i < mChildList.size(); ++ i ) {
+    mStatsList[i].name = name_list[i];
+    mOrder[i] = i;
+    if ( mParallel ) {
+      mChildList[i]->set_cancel_flag(&mCancel);
+    }
+  }
+}
+
+// @brief デストラクタ
+LbMAX::~LbMAX()
+{
+  {
+    std::lock_guard<std::mutex> lock{mMutex};
+    mQuit = true;
+  }
+  mStartCond.notify_all();
+  for ( auto& th: mThreadList ) {
+    th.join();
+  }
+}
+
 // @brief 下界の計算をする．
 int
 LbMAX::calc(
   const McMatrix& matrix
 )
 {
+  return calc(matrix, INT_MAX);
+}
+
+// @brief 目標値を指定して下界の計算をする
+int
+LbMAX::calc(
+  const McMatrix& matrix,
+  int target
+)
+{
+  if ( mParallel ) {
+    return calc_parallel(matrix, target);
+  }
+
+  // 1回あたりの平均時間の短い順に並べる．
+  // まだ呼んでいない子供は 0 とみなすので最初に呼ばれる．
+  auto mean_time = [&](SizeType i) {
+    auto& stats = mStatsList[i];
+    return stats.call_num > 0 ? stats.time / stats.call_num : 0.0;
+  };
+  std::stable_sort(mOrder.begin(), mOrder.end(),
+		   [&](SizeType a, SizeType b) {
+		     return mean_time(a) < mean_time(b);
+		   });
+
   int max_val = 0;
-  for ( auto& calc: mChildList ) {
-    int val = calc->calc(matrix);
+  for ( auto i: mOrder ) {
+    auto& stats = mStatsList[i];
+    auto start = std::chrono::steady_clock::now();
+    int val = mChildList[i]->calc(matrix, target);
+    std::chrono::duration<double> elapsed
+      = std::chrono::steady_clock::now() - start;
+    ++ stats.call_num;
+    stats.time += elapsed.count();
     if ( max_val < val ) {
       max_val = val;
     }
+    if ( max_val >= target ) {
+      // 残りの子供は計算しなくてよい．
+      ++ stats.cut_num;
+      break;
+    }
   }
   return max_val;
 }
 
+// @brief 子供を並列に計算する．
+int
+LbMAX::calc_parallel(
+  const McMatrix& matrix,
+  int target
+)
+{
+  SizeType n = mChildList.size();
+  if ( mThreadList.empty() ) {
+    mThreadList.reserve(n - 1);
+    for ( SizeType i = 1; i < n; ++ i ) {
+      mThreadList.push_back(std::thread{[this, i]() { run_worker(i); }});
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock{mMutex};
+    mMatrix = &matrix;
+    mTarget = target;
+    mCancel = false;
+    mPending = n - 1;
+    mError = nullptr;
+    ++ mGeneration;
+  }
+  mStartCond.notify_all();
+
+  // 0 番目の子供はこのスレッドで計算する．
+  std::exception_ptr error;
+  try {
+    calc_child(0, matrix, target);
+  }
+  catch ( ... ) {
+    error = std::current_exception();
+    mCancel = true;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock{mMutex};
+    mDoneCond.wait(lock, [&]() { return mPending == 0; });
+    if ( !error ) {
+      error = mError;
+    }
+  }
+  if ( error ) {
+    std::rethrow_exception(error);
+  }
+
+  int max_val = 0;
+  for ( auto val: mValList ) {
+    if ( max_val < val ) {
+      max_val = val;
+    }
+  }
+  return max_val;
+}
+
+// @brief 子供の計算を行う．
+void
+LbMAX::calc_child(
+  SizeType i,
+  const McMatrix& matrix,
+  int target
+)
+{
+  auto& stats = mStatsList[i];
+  auto start = std::chrono::steady_clock::now();
+  int val = mChildList[i]->calc(matrix, target);
+  std::chrono::duration<double> elapsed
+    = std::chrono::steady_clock::now() - start;
+  ++ stats.call_num;
+  stats.time += elapsed.count();
+  mValList[i] = val;
+  if ( val >= target ) {
+    // 他の子供は計算しなくてよい．
+    ++ stats.cut_num;
+    mCancel = true;
+  }
+  else if ( mCancel ) {
+    ++ stats.cancel_num;
+  }
+}
+
+// @brief ワーカースレッドの本体
+void
+LbMAX::run_worker(
+  SizeType i
+)
+{
+  SizeType generation = 0;
+  for ( ; ; ) {
+    const McMatrix* matrix;
+    int target;
+    {
+      std::unique_lock<std::mutex> lock{mMutex};
+      mStartCond.wait(lock, [&]() {
+	return mQuit || mGeneration != generation;
+      });
+      if ( mQuit ) {
+	return;
+      }
+      generation = mGeneration;
+      matrix = mMatrix;
+      target = mTarget;
+    }
+    try {
+      calc_child(i, *matrix, target);
+    }
+    catch ( ... ) {
+      mCancel = true;
+      std::lock_guard<std::mutex> lock{mMutex};
+      if ( !mError ) {
+	mError = std::current_exception();
+      }
+    }
+    {
+      std::lock_guard<std::mutex> lock{mMutex};
+      -- mPending;
+    }
+    mDoneCond.notify_one();
+  }
+}
+
+// @brief 直前の calc() で求めた列の被約費用を返す．
+const vector<double>*
+LbMAX::reduced_cost() const
+{
+  for ( auto& calc: mChildList ) {
+    auto rc = calc->reduced_cost();
+    if ( rc != nullptr ) {
+      return rc;
+    }
+  }
+  return nullptr;
+}
+
+// @brief 直前の calc() で求めた緩和問題の値を返す．
+double
+LbMAX::relaxed_value() const
+{
+  for ( auto& calc: mChildList ) {
+    if ( calc->reduced_cost() != nullptr ) {
+      return calc->relaxed_value();
+    }
+  }
+  return 0.0;
+}
+
+// @brief 計算を打ち切るためのフラグを設定する．
+void
+LbMAX::set_cancel_flag(
+  const std::atomic<bool>* flag
+)
+{
+  LbCalc::set_cancel_flag(flag);
+  if ( !mParallel ) {
+    for ( auto& calc: mChildList ) {
+      calc->set_cancel_flag(flag);
+    }
+  }
+}
+
+// @brief 自前のスレッドを作って計算する時 true を返す．
+bool
+LbMAX::spawns_threads() const
+{
+  if ( mParallel ) {
+    return true;
+  }
+  for ( auto& calc: mChildList ) {
+    if ( calc->spawns_threads() ) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// @brief 統計情報を出力する．
+void
+LbMAX::print_stats(
+  ostream& s
+) const
+{
+  s << "LbMAX statistics:" << endl;
+  for ( auto& stats: mStatsList ) {
+    s << "  " << stats.name << ": "
+      << stats.call_num << " calls, "
+      << stats.cut_num << " cuts, "
+      << stats.cancel_num << " cancels, "
+      << stats.time << "(s)";
+    if ( stats.call_num > 0 ) {
+      s << ", " << (stats.time / stats.call_num) * 1.0e6 << "(us)/call";
+    }
+    s << endl;
+  }
+}
+
+// @brief 同じ構成の LbCalc の統計情報を足し込む．
+void
+LbMAX::merge_stats(
+  const LbCalc& src
+)
+{
+  auto src_max = dynamic_cast<const LbMAX*>(&src);
+  ASSERT_COND( src_max != nullptr );
+  ASSERT_COND( src_max->mStatsList.size() == mStatsList.size() );
+  for ( SizeType i = 0; i < mStatsList.size(); ++ i ) {
+    auto& dst_stats = mStatsList[i];
+    auto& src_stats = src_max->mStatsList[i];
+    dst_stats.call_num += src_stats.call_num;
+    dst_stats.cut_num += src_stats.cut_num;
+    dst_stats.cancel_num += src_stats.cancel_num;
+    dst_stats.time += src_stats.time;
+  }
+}
+
 END_NAMESPACE_YM_MINCOV
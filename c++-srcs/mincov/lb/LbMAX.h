@@ -9,6 +9,9 @@
 /// All rights reserved.
 
 #include "mincov/LbCalc.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 
 BEGIN_NAMESPACE_YM_MINCOV
@@ -16,6 +19,20 @@ BEGIN_NAMESPACE_YM_MINCOV
 //////////////////////////////////////////////////////////////////////
 /// @class LbMAX LbMAX.h "LbMAX.h"
 /// @brief 複数の LbCalc の MAX を計算するクラス
+///
+/// * 目標値を指定した calc() では1回あたりの平均時間が短い子供から順に
+///   計算し，目標値に達した時点で打ち切る．
+/// * 子供ごとに呼び出し回数，計算時間，目標値に達した回数を数えて
+///   print_stats() で出力する．child_list の順序を決める参考にする．
+/// * parallel が true の時は子供を並列に計算する．
+///   1つ目の子供は呼び出したスレッドで，残りは最初の calc() で作る
+///   子供ごとのスレッドで計算する．スレッドは LbMAX が消えるまで使い回す．
+///   どれかの子供が目標値に達したら打ち切りフラグを立てて
+///   他の子供の計算を打ち切らせる．
+///   この時，外から set_cancel_flag() で設定したフラグは子供に伝わらない．
+/// * スレッドは LbMAX ごとに作られるので，インスタンスをスレッドごと，
+///   ブロックごとに作る Exact の並列探索("threads" が 2 以上)とは
+///   組み合わせられない．(Exact のコンストラクタで例外を送出する)
 //////////////////////////////////////////////////////////////////////
 class LbMAX :
   public LbCalc
@@ -24,13 +41,13 @@ public:
 
   /// @brief コンストラクタ
   LbMAX(
-    vector<unique_ptr<LbCalc>>&& child_list
-  ) : mChildList{std::move(child_list)}
-  {
-  }
+    vector<unique_ptr<LbCalc>>&& child_list, ///< [in] 子供のリスト
+    const vector<string>& name_list,         ///< [in] 子供の名前のリスト
+    bool parallel                            ///< [in] 並列に計算する時 true
+  );
 
   /// @brief デストラクタ
-  ~LbMAX() = default;
+  ~LbMAX();
 
 
 public:
@@ -44,15 +61,155 @@ public:
     const McMatrix& matrix
   ) override;
 
+  /// @brief 目標値を指定して下界の計算をする
+  int
+  calc(
+    const McMatrix& matrix,
+    int target
+  ) override;
+
+  /// @brief 直前の calc() で求めた列の被約費用を返す．
+  ///
+  /// 被約費用を持つ最初の子供のものを返す．
+  const vector<double>*
+  reduced_cost() const override;
+
+  /// @brief 直前の calc() で求めた緩和問題の値を返す．
+  double
+  relaxed_value() const override;
+
+  /// @brief 計算を打ち切るためのフラグを設定する．
+  ///
+  /// 逐次に計算する時は子供にも設定する．
+  void
+  set_cancel_flag(
+    const std::atomic<bool>* flag
+  ) override;
+
+  /// @brief 自前のスレッドを作って計算する時 true を返す．
+  ///
+  /// parallel が true の時か，そうでなくても子供がスレッドを作る時に
+  /// true を返す．
+  bool
+  spawns_threads() const override;
+
+  /// @brief 統計情報を出力する．
+  void
+  print_stats(
+    ostream& s
+  ) const override;
+
+  /// @brief 同じ構成の LbCalc の統計情報を足し込む．
+  void
+  merge_stats(
+    const LbCalc& src
+  ) override;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 子供を並列に計算する．
+  int
+  calc_parallel(
+    const McMatrix& matrix,
+    int target
+  );
+
+  /// @brief 子供の計算を行う．
+  ///
+  /// 値は mValList[i] に入る．
+  void
+  calc_child(
+    SizeType i,
+    const McMatrix& matrix,
+    int target
+  );
+
+  /// @brief ワーカースレッドの本体
+  void
+  run_worker(
+    SizeType i ///< [in] 担当する子供の番号
+  );
+
 
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
+  // 子供ごとの統計情報
+  struct Stats
+  {
+    // 名前
+    string name;
+
+    // calc() を呼んだ回数
+    SizeType call_num{0};
+
+    // 目標値に達した回数
+    SizeType cut_num{0};
+
+    // 打ち切りフラグが立った後に終わった回数
+    SizeType cancel_num{0};
+
+    // 計算時間の合計(秒)
+    double time{0.0};
+  };
+
   // 下界の計算クラスのリスト
   vector<unique_ptr<LbCalc>> mChildList;
 
+  // 子供ごとの統計情報のリスト
+  vector<Stats> mStatsList;
+
+  // 子供を計算する順序
+  vector<SizeType> mOrder;
+
+  // 並列に計算する時 true
+  bool mParallel;
+
+  // 以下は並列に計算する時に用いる．
+
+  // 子供の打ち切りフラグ
+  std::atomic<bool> mCancel{false};
+
+  // ワーカースレッドのリスト
+  // i 番目のスレッドは i + 1 番目の子供を計算する．
+  vector<std::thread> mThreadList;
+
+  // 以下の変数を守るミューテックス
+  std::mutex mMutex;
+
+  // 計算の開始を知らせる条件変数
+  std::condition_variable mStartCond;
+
+  // 計算の終了を知らせる条件変数
+  std::condition_variable mDoneCond;
+
+  // 計算を依頼した回数
+  SizeType mGeneration{0};
+
+  // 計算の終わっていないワーカーの数
+  SizeType mPending{0};
+
+  // ワーカーを終了させる時 true
+  bool mQuit{false};
+
+  // 計算対象の行列
+  const McMatrix* mMatrix{nullptr};
+
+  // 目標値
+  int mTarget{INT_MAX};
+
+  // 子供ごとの計算結果
+  vector<int> mValList;
+
+  // ワーカーで起きた例外
+  std::exception_ptr mError;
+
 };
 
 END_NAMESPACE_YM_MINCOV
@@ -9,6 +9,8 @@
 /// All rights reserved.
 
 #include "mincov/LbCalc.h"
+#include "ConflictGraph.h"
+#include "MisBucket.h"
 
 
 BEGIN_NAMESPACE_YM_MINCOV
@@ -17,7 +19,8 @@ BEGIN_NAMESPACE_YM_MINCOV
 /// @class LbMIS1 LbMIS1.h "LbMIS1.h"
 /// @brief MIS(maximum independent set) を用いた下界の計算クラス
 ///
-/// ノードをリンクトリストでつなぐ実装
+/// 次数の小さい行から貪欲に独立集合を作る．
+/// 次数の最小値は MisBucket で取り出す．
 //////////////////////////////////////////////////////////////////////
 class LbMIS1 :
   public LbCalc
@@ -33,6 +36,20 @@ public:
     const McMatrix& matrix
   ) override;
 
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 行の衝突グラフ
+  // calc() のたびに差分だけを更新する．
+  ConflictGraph mGraph;
+
+  // 未処理の行のバケツキュー
+  // ノード番号は行番号と同じで，キーは未処理の隣接ノード数
+  MisBucket mBucket;
+
 };
 
 END_NAMESPACE_YM_MINCOV
@@ -8,8 +8,6 @@
 
 #include "LbMIS2.h"
 #include "mincov/McMatrix.h"
-#include "MisNode.h"
-#include "MisNodeHeap.h"
 
 
 BEGIN_NAMESPACE_YM_MINCOV
@@ -29,75 +27,95 @@ LbMIS2::calc(
   }
 
   // MIS を用いた下限
-  // 各行に対応する Node というオブジェクトを作る．
-  // ndoe_array[row_pos] に row_pos の行の Node が入る．
-  // top から Node::mNext を使ってリンクとリストを作る．
+  // 各行の重みはその行を被覆する列の最小コストとする．
   SizeType rs = matrix.row_size();
-  SizeType rn = matrix.active_row_num();
-
-  MisNodeHeap node_heap(rs);
-
-  vector<MisNode*> node_array(rn, nullptr);
-
-  SizeType idx = 0;
-  for ( auto row_pos: matrix.row_head_list() ) {
-    MisNode* node = node_heap.node(idx);
-    ++ idx;
-    node->set_row_pos(row_pos);
-    node_array[row_pos] = node;
+  if ( mWeight.size() != rs ) {
+    mWeight.resize(rs);
   }
-
-  // 同じ列を共有する行の関係を Node::mAdjLink で表す．
-  // node1 と列を共有する行の Node が node1->mAdjLink[0:node1->mAdjNum -1]
-  // に入る．
-  // node1->mNum も node1->mAdjNum で初期化される．
-  vector<bool> mark(rn, false);
-  for ( auto row_pos: matrix.row_head_list() ) {
-    // マークを用いて隣接関係を作る．
-    vector<MisNode*> adj_link;
-    for ( auto col_pos1: matrix.row_list(row_pos) ) {
-      for ( auto row_pos2: matrix.col_list(col_pos1) ) {
-	if ( !mark[row_pos2] ) {
-	  mark[row_pos2] = true;
-	  adj_link.push_back(node_array[row_pos2]);
+  mWeightList.clear();
+  matrix.with_lists([&](const auto& lists) {
+    for ( auto row_pos: matrix.row_head_list() ) {
+      int min_cost = INT_MAX;
+      for ( auto col_pos: lists.row_list(row_pos) ) {
+	if ( min_cost > matrix.col_cost(col_pos) ) {
+	  min_cost = matrix.col_cost(col_pos);
 	}
       }
+      mWeight[row_pos] = min_cost;
+      mWeightList.push_back(min_cost);
     }
-    // マークを消す．
-    for ( auto node: adj_link ) {
-      mark[node->row_pos()] = false;
-    }
-    MisNode* node1 = node_array[row_pos];
-    node1->set_adj_link(std::move(adj_link));
-    node_heap.put(node1);
+  });
+  std::sort(mWeightList.begin(), mWeightList.end());
+  mWeightList.erase(std::unique(mWeightList.begin(), mWeightList.end()),
+		    mWeightList.end());
+
+  // 同じ列を共有する行の関係は mGraph で表す．
+  // 未処理の隣接ノード数をキーにして重みのクラスごとに mBucket に入れる．
+  mGraph.update(matrix);
+  SizeType max_degree = 0;
+  for ( auto row_pos: matrix.row_head_list() ) {
+    max_degree = std::max(max_degree, mGraph.degree(row_pos));
+  }
+  // 重みの種類が多い時は順位で MAX_CLASS_NUM 個にまとめる．
+  SizeType nw = mWeightList.size();
+  SizeType nc = std::min(nw, MAX_CLASS_NUM);
+  mBucket.init(rs, nc, max_degree);
+  for ( auto row_pos: matrix.row_head_list() ) {
+    auto p = std::lower_bound(mWeightList.begin(), mWeightList.end(),
+			      mWeight[row_pos]);
+    SizeType rank = p - mWeightList.begin();
+    mBucket.put(row_pos, rank * nc / nw, mGraph.degree(row_pos));
   }
 
-  // 未処理の MisNode のうち Node::mNum が最小のものを取り出し，解に加える．
-  // 実際にはその行を被覆する列の最小コストを解に足す．
+  // 未処理の行のうち 重み / (隣接ノード数 + 1) が最大のものを取り出し，
+  // その重みを解に足す．
   int cost = 0;
-  while ( !node_heap.empty() ) {
-    MisNode* best_node = node_heap.get_min();
-
-    // best_node に対応する行を被覆する列の最小コストを求める．
-    int min_cost = INT_MAX;
-    for ( auto cpos: matrix.row_list(best_node->row_pos()) ) {
-      if ( min_cost > matrix.col_cost(cpos) ) {
-	min_cost = matrix.col_cost(cpos);
+  for ( ; ; ) {
+    // 各クラスの先頭を比べる．
+    // まとめたクラスの中では重みが異なるので行の重みを用いる．
+    // 比は整数の掛け算で比べる．
+    auto best_row = MisBucket::BAD_ID;
+    std::uint64_t best_w = 0;
+    std::uint64_t best_d = 1;
+    for ( SizeType cls = nc; cls -- > 0; ) {
+      auto row_pos = mBucket.min_node(cls);
+      if ( row_pos == MisBucket::BAD_ID ) {
+	continue;
       }
+      std::uint64_t w = mWeight[row_pos];
+      std::uint64_t d = mBucket.key(row_pos) + 1;
+      if ( best_row == MisBucket::BAD_ID || w * best_d > best_w * d ) {
+	best_row = row_pos;
+	best_w = w;
+	best_d = d;
+      }
+    }
+    if ( best_row == MisBucket::BAD_ID || canceled() ) {
+      // 途中までの行も独立集合なので打ち切っても下界になる．
+      break;
     }
-    cost += min_cost;
+    cost += mWeight[best_row];
 
-    for ( SizeType i = 0; i < best_node->adj_size(); ++ i ) {
-      // best_node に隣接しているノードも処理済みとする．
-      MisNode* node2 = best_node->adj_node(i);
-      if ( !node2->deleted() ) {
-	node_heap.delete_node(node2);
-	// さらにこのノードに隣接しているノードの mNum を減らす．
-	for ( SizeType j = 0; j < node2->adj_size(); ++ j ) {
-	  MisNode* node3 = node2->adj_node(j);
-	  if ( !node3->deleted() ) {
-	    node3->dec_adj_num();
-	    node_heap.update(node3);
+    // 処理済みの印をつける．
+    mBucket.erase(best_row);
+    // best_row に隣接している行も処理済みとする．
+    for ( auto e2 = mGraph.adj_begin(best_row);
+	  e2 < mGraph.adj_end(best_row); ++ e2 ) {
+      if ( !mGraph.is_valid(e2) ) {
+	continue;
+      }
+      auto row_pos2 = mGraph.adj_row(e2);
+      if ( mBucket.contains(row_pos2) ) {
+	mBucket.erase(row_pos2);
+	// さらにこの行に隣接している行の隣接ノード数を減らす．
+	for ( auto e3 = mGraph.adj_begin(row_pos2);
+	      e3 < mGraph.adj_end(row_pos2); ++ e3 ) {
+	  if ( !mGraph.is_valid(e3) ) {
+	    continue;
+	  }
+	  auto row_pos3 = mGraph.adj_row(e3);
+	  if ( mBucket.contains(row_pos3) ) {
+	    mBucket.dec_key(row_pos3);
 	  }
 	}
       }
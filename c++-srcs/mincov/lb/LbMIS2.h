@@ -9,6 +9,8 @@
 /// All rights reserved.
 
 #include "mincov/LbCalc.h"
+#include "ConflictGraph.h"
+#include "MisBucket.h"
 
 
 BEGIN_NAMESPACE_YM_MINCOV
@@ -17,7 +19,19 @@ BEGIN_NAMESPACE_YM_MINCOV
 /// @class LbMIS2 LbMIS2.h "LbMIS2.h"
 /// @brief MIS(maximum independent set) を用いた下界の計算クラス
 ///
-/// ヒープを使って最小要素を取り出す．
+/// 行を被覆する列の最小コストを重みとして
+/// (重み) / (未処理の隣接ノード数 + 1) の大きい行から貪欲に独立集合を作る．
+/// 次数だけで選ぶ LbMIS1 よりもコストが一様でない時に強い下界となる．
+///
+/// 行は重みごとのクラスに分けて MisBucket に入れる．
+/// 同じ重みの中では次数最小の行が最良なので，
+/// 各クラスの先頭だけを比べればよい．
+/// 重みの種類が MAX_CLASS_NUM を超える時は重みの順位で
+/// MAX_CLASS_NUM 個のクラスにまとめる．この時クラスの先頭は
+/// クラス内で次数最小の行となり，最良の行とは限らないが，
+/// どの行を選んでも独立集合になるので下界としては正しい．
+/// クラス数を抑えることで MisBucket の大きさと
+/// 1回の選択で比べる先頭の数を重みの種類によらず一定にする．
 //////////////////////////////////////////////////////////////////////
 class LbMIS2 :
   public LbCalc
@@ -33,6 +47,36 @@ public:
     const McMatrix& matrix
   ) override;
 
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる定数
+  //////////////////////////////////////////////////////////////////////
+
+  // クラス数の上限
+  static constexpr SizeType MAX_CLASS_NUM = 16;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 行の衝突グラフ
+  // calc() のたびに差分だけを更新する．
+  ConflictGraph mGraph;
+
+  // 未処理の行のバケツキュー
+  // ノード番号は行番号と同じで，キーは未処理の隣接ノード数
+  MisBucket mBucket;
+
+  // 行ごとの重み
+  vector<int> mWeight;
+
+  // 異なる重みのリスト
+  // 昇順に並んでいる．
+  vector<int> mWeightList;
+
 };
 
 END_NAMESPACE_YM_MINCOV
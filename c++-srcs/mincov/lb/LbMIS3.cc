@@ -3,12 +3,11 @@
 /// @brief LbMIS3 の実装ファイル
 /// @author Yusuke Matsunaga (松永 裕介)
 ///
-/// Copyright (C) 2014, 2021, 2022 Yusuke Matsunaga
+/// Copyright (C) 2014, 2021, 2022, 2025 Yusuke Matsunaga
 /// All rights reserved.
 
 #include "LbMIS3.h"
 #include "mincov/McMatrix.h"
-#include "ym/UdGraph.h"
 
 
 BEGIN_NAMESPACE_YM_MINCOV
@@ -23,68 +22,134 @@ LbMIS3::calc(
   const McMatrix& matrix
 )
 {
+  return calc(matrix, INT_MAX);
+}
+
+// @brief 目標値を指定して下界の計算をする
+int
+LbMIS3::calc(
+  const McMatrix& matrix,
+  int target
+)
+{
+  ++ mCallNum;
   if ( matrix.active_row_num() == 0 ) {
     return 0;
   }
 
-  // MIS を用いた下限
-  // 各行に対応する Node というオブジェクトを作る．
-  // ndoe_array[row_pos] に row_pos の行の Node が入る．
-  // top から Node::mNext を使ってリンクとリストを作る．
+  // 各行の重みはその行を被覆する列の最小コストとする．
   SizeType rs = matrix.row_size();
-  SizeType rn = matrix.active_row_num();
-
-  UdGraph graph(rs);
-
-  vector<SizeType> row_map(rs, 0);
-
-  SizeType idx = 0;
-  for ( auto row_pos: matrix.row_head_list() ) {
-    row_map[row_pos] = idx;
-    ++ idx;
+  if ( mWeight.size() != rs ) {
+    mWeight.resize(rs);
+    mRowMap.resize(rs);
   }
-
-  // 同じ列を共有する行の関係を Node::mAdjLink で表す．
-  // node1 と列を共有する行の Node が node1->mAdjLink[0:node1->mAdjNum -1]
-  // に入る．
-  // node1->mNum も node1->mAdjNum で初期化される．
-  vector<bool> mark(rn, false);
-  for ( auto row_pos: matrix.row_head_list() ) {
-    // マークを用いて隣接関係を作る．
-    SizeType id1 = row_map[row_pos];
-    vector<SizeType> mark_list;
-    for ( auto col_pos1: matrix.row_list(row_pos) ) {
-      for ( auto row_pos2: matrix.col_list(col_pos1) ) {
-	if ( !mark[row_pos2] ) {
-	  mark[row_pos2] = true;
-	  mark_list.push_back(row_pos2);
-	  SizeType id2 = row_map[row_pos2];
-	  graph.connect(id1, id2);
+  mRowList.clear();
+  matrix.with_lists([&](const auto& lists) {
+    for ( auto row_pos: matrix.row_head_list() ) {
+      int min_cost = INT_MAX;
+      for ( auto col_pos: lists.row_list(row_pos) ) {
+	if ( min_cost > matrix.col_cost(col_pos) ) {
+	  min_cost = matrix.col_cost(col_pos);
 	}
       }
+      mWeight[row_pos] = min_cost;
+      mRowList.push_back(row_pos);
+    }
+  });
+
+  // 同じ列を共有する行の関係は mGraph で表す．
+  mGraph.update(matrix);
+
+  // (重み) / (次数 + 1) の大きい順に貪欲に独立集合を作る．
+  std::sort(mRowList.begin(), mRowList.end(),
+	    [&](SizeType a, SizeType b) {
+	      std::uint64_t wa = mWeight[a];
+	      std::uint64_t wb = mWeight[b];
+	      std::uint64_t da = mGraph.degree(a) + 1;
+	      std::uint64_t db = mGraph.degree(b) + 1;
+	      return wa * db > wb * da;
+	    });
+  mBlocked.clear();
+  mBlocked.resize(rs, false);
+  int cost = 0;
+  for ( auto row_pos: mRowList ) {
+    if ( mBlocked[row_pos] ) {
+      continue;
     }
-    // マークを消す．
-    for ( SizeType pos: mark_list ) {
-      mark[pos] = false;
+    cost += mWeight[row_pos];
+    for ( auto e = mGraph.adj_begin(row_pos);
+	  e < mGraph.adj_end(row_pos); ++ e ) {
+      if ( mGraph.is_valid(e) ) {
+	mBlocked[mGraph.adj_row(e)] = true;
+      }
     }
   }
 
-  // 各行を被覆する列の最小コストを求める．
-  for ( auto row_pos: matrix.row_head_list() ) {
-    SizeType id = row_map[row_pos];
-    int min_cost = INT_MAX;
-    for ( auto cpos: matrix.row_list(row_pos) ) {
-      if ( min_cost > matrix.col_cost(cpos) ) {
-	min_cost = matrix.col_cost(cpos);
+  SizeType rn = mRowList.size();
+  if ( cost >= target || rn > mMaxRows || mNodeLimit == 0 ) {
+    return cost;
+  }
+
+  // 貪欲法の順にノード番号をつけて分枝限定法で改善する．
+  // クリーク分割は番号の小さいノードから行うので，
+  // 重みの大きなノードが先にクリークの代表になる．
+  mSolver.init(rn);
+  for ( SizeType id = 0; id < rn; ++ id ) {
+    auto row_pos = mRowList[id];
+    mRowMap[row_pos] = id;
+    mSolver.set_weight(id, mWeight[row_pos]);
+  }
+  for ( SizeType id = 0; id < rn; ++ id ) {
+    auto row_pos = mRowList[id];
+    for ( auto e = mGraph.adj_begin(row_pos);
+	  e < mGraph.adj_end(row_pos); ++ e ) {
+      auto row_pos2 = mGraph.adj_row(e);
+      if ( row_pos2 > row_pos && mGraph.is_valid(e) ) {
+	mSolver.connect(id, mRowMap[row_pos2]);
       }
     }
   }
+  auto cost1 = mSolver.solve(cost, target, mNodeLimit, cancel_flag());
 
-  auto node_set = graph.max_clique();
-#warning "TODO: 未完成"
-  int cost = 0;
+  ++ mSearchCallNum;
+  if ( mSolver.is_optimal() ) {
+    ++ mOptimalNum;
+  }
+  if ( cost1 > cost ) {
+    ++ mImproveNum;
+  }
+  mSearchNum += mSolver.search_num();
 
-  return cost;
+  return cost1;
+}
+
+// @brief 統計情報を出力する．
+void
+LbMIS3::print_stats(
+  ostream& s
+) const
+{
+  s << "LbMIS3 statistics:" << endl
+    << "  " << mCallNum << " calls, "
+    << mSearchCallNum << " searches, "
+    << mOptimalNum << " optimal, "
+    << mImproveNum << " improved, "
+    << mSearchNum << " search nodes" << endl;
+}
+
+// @brief 同じ構成の LbCalc の統計情報を足し込む．
+void
+LbMIS3::merge_stats(
+  const LbCalc& src
+)
+{
+  auto src_mis = dynamic_cast<const LbMIS3*>(&src);
+  ASSERT_COND( src_mis != nullptr );
+  mCallNum += src_mis->mCallNum;
+  mSearchCallNum += src_mis->mSearchCallNum;
+  mOptimalNum += src_mis->mOptimalNum;
+  mImproveNum += src_mis->mImproveNum;
+  mSearchNum += src_mis->mSearchNum;
 }
 
 END_NAMESPACE_YM_MINCOV
@@ -9,6 +9,8 @@
 /// All rights reserved.
 
 #include "mincov/LbCalc.h"
+#include "ConflictGraph.h"
+#include "MwisSolver.h"
 
 
 BEGIN_NAMESPACE_YM_MINCOV
@@ -17,11 +19,33 @@ BEGIN_NAMESPACE_YM_MINCOV
 /// @class LbMIS3 LbMIS3.h "LbMIS3.h"
 /// @brief MIS(maximum independent set) を用いた下界の計算クラス
 ///
-/// get_mis() 関数を使う
+/// 行を被覆する列の最小コストを重みとして，
+/// 行の衝突グラフの重み付き最大独立集合を MwisSolver で求める．
+///
+/// * まず (重み) / (次数 + 1) の順の貪欲法で独立集合を作り，
+///   それを初期解として分枝限定法で改善する．
+/// * 分枝限定法は探索ノード数が node_limit を超えたら打ち切る．
+///   アクティブな行数が max_rows を超える時は貪欲法の値だけを用いる．
+/// * どちらの場合も得られるのは独立集合なので値は下界となる．
 //////////////////////////////////////////////////////////////////////
 class LbMIS3 :
   public LbCalc
 {
+public:
+
+  /// @brief コンストラクタ
+  LbMIS3(
+    SizeType node_limit, ///< [in] 分枝限定法の探索ノード数の上限
+    SizeType max_rows    ///< [in] 分枝限定法を行う最大の行数
+  ) : mNodeLimit{node_limit},
+      mMaxRows{max_rows}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~LbMIS3() = default;
+
+
 public:
   //////////////////////////////////////////////////////////////////////
   // 外部インターフェイス
@@ -33,6 +57,71 @@ public:
     const McMatrix& matrix
   ) override;
 
+  /// @brief 目標値を指定して下界の計算をする
+  int
+  calc(
+    const McMatrix& matrix,
+    int target
+  ) override;
+
+  /// @brief 統計情報を出力する．
+  void
+  print_stats(
+    ostream& s
+  ) const override;
+
+  /// @brief 同じ構成の LbCalc の統計情報を足し込む．
+  void
+  merge_stats(
+    const LbCalc& src
+  ) override;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 分枝限定法の探索ノード数の上限
+  SizeType mNodeLimit;
+
+  // 分枝限定法を行う最大の行数
+  SizeType mMaxRows;
+
+  // 行の衝突グラフ
+  // calc() のたびに差分だけを更新する．
+  ConflictGraph mGraph;
+
+  // 重み付き最大独立集合を求めるオブジェクト
+  MwisSolver mSolver;
+
+  // 行ごとの重み
+  vector<int> mWeight;
+
+  // 行ごとの選べない印
+  vector<bool> mBlocked;
+
+  // 貪欲法の順に並べた行のリスト
+  vector<SizeType> mRowList;
+
+  // 行番号から MwisSolver のノード番号への写像
+  vector<SizeType> mRowMap;
+
+  // calc() の呼び出し回数
+  SizeType mCallNum{0};
+
+  // 分枝限定法を行った回数
+  SizeType mSearchCallNum{0};
+
+  // 分枝限定法が打ち切られずに終わった回数
+  SizeType mOptimalNum{0};
+
+  // 分枝限定法で貪欲法の値を改善した回数
+  SizeType mImproveNum{0};
+
+  // 分枝限定法の探索ノード数の総和
+  SizeType mSearchNum{0};
+
 };
 
 END_NAMESPACE_YM_MINCOV
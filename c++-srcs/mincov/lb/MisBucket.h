@@ -0,0 +1,323 @@
+#ifndef MISBUCKET_H
+#define MISBUCKET_H
+
+/// @file MisBucket.h
+/// @brief MisBucket のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "mincov/mincov_nsdef.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+/// @class MisBucket MisBucket.h "MisBucket.h"
+/// @brief LbMIS で用いる次数のバケツキュー
+///
+/// ノードを (クラス, キー) ごとのバケツに入れて管理する．
+/// キーは次数のような小さな整数で，1ずつしか減らないものとする．
+///
+/// * キーの減少は O(1) で行える．
+/// * クラスごとに最小のキーの位置を覚えておき，
+///   取り出す時には空でないバケツまで進める．
+///   位置が戻るのはキーが減った時だけなので取り出しはならし O(1) となる．
+/// * クラスはコストの異なるノードを分けるために用いる．
+///   クラスを使わない時はすべてのノードをクラス 0 に入れればよい．
+//////////////////////////////////////////////////////////////////////
+class MisBucket
+{
+public:
+
+  /// @brief 無効なノード番号
+  static constexpr SizeType BAD_ID = static_cast<SizeType>(-1);
+
+  /// @brief コンストラクタ
+  MisBucket() = default;
+
+  /// @brief デストラクタ
+  ~MisBucket() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 初期化する．
+  ///
+  /// 空のキューとなる．
+  void
+  init(
+    SizeType node_size, ///< [in] ノード数
+    SizeType class_num, ///< [in] クラス数
+    SizeType max_key    ///< [in] キーの最大値
+  );
+
+  /// @brief ノードを追加する．
+  void
+  put(
+    SizeType id,  ///< [in] ノード番号 ( 0 <= id < node_size )
+    SizeType cls, ///< [in] クラス ( 0 <= cls < class_num )
+    SizeType key  ///< [in] キー ( 0 <= key <= max_key )
+  );
+
+  /// @brief ノードを取り除く．
+  void
+  erase(
+    SizeType id ///< [in] ノード番号
+  );
+
+  /// @brief ノードのキーを1つ減らす．
+  void
+  dec_key(
+    SizeType id ///< [in] ノード番号
+  );
+
+  /// @brief ノードがキューに含まれている時 true を返す．
+  bool
+  contains(
+    SizeType id ///< [in] ノード番号
+  ) const
+  {
+    return mIn[id];
+  }
+
+  /// @brief ノードのキーを返す．
+  SizeType
+  key(
+    SizeType id ///< [in] ノード番号
+  ) const
+  {
+    return mKey[id];
+  }
+
+  /// @brief キューが空の時 true を返す．
+  bool
+  empty() const
+  {
+    return mNum == 0;
+  }
+
+  /// @brief クラス数を返す．
+  SizeType
+  class_num() const
+  {
+    return mMinKey.size();
+  }
+
+  /// @brief クラスの中でキーが最小のノードを返す．
+  ///
+  /// ノードはキューに残る．
+  /// クラスが空の時は BAD_ID を返す．
+  SizeType
+  min_node(
+    SizeType cls ///< [in] クラス
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief バケツ番号を返す．
+  SizeType
+  bucket(
+    SizeType cls,
+    SizeType key
+  ) const
+  {
+    return cls * (mMaxKey + 1) + key;
+  }
+
+  /// @brief ノードをバケツにつなぐ．
+  void
+  link(
+    SizeType id
+  );
+
+  /// @brief ノードをバケツから外す．
+  void
+  unlink(
+    SizeType id
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // キーの最大値
+  SizeType mMaxKey{0};
+
+  // バケツごとの先頭のノード
+  vector<SizeType> mHead;
+
+  // クラスごとのキーの最小値の候補
+  // これより小さいキーのバケツは空になっている．
+  vector<SizeType> mMinKey;
+
+  // ノードごとの前のノード
+  vector<SizeType> mPrev;
+
+  // ノードごとの次のノード
+  vector<SizeType> mNext;
+
+  // ノードごとのクラス
+  vector<SizeType> mClass;
+
+  // ノードごとのキー
+  vector<SizeType> mKey;
+
+  // ノードごとのキューに含まれている印
+  vector<bool> mIn;
+
+  // キューに含まれているノード数
+  SizeType mNum{0};
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+// インライン関数の定義
+//////////////////////////////////////////////////////////////////////
+
+// @brief 初期化する．
+inline
+void
+MisBucket::init(
+  SizeType node_size,
+  SizeType class_num,
+  SizeType max_key
+)
+{
+  mMaxKey = max_key;
+  mHead.clear();
+  mHead.resize(class_num * (max_key + 1), BAD_ID);
+  mMinKey.clear();
+  mMinKey.resize(class_num, max_key + 1);
+  if ( mPrev.size() != node_size ) {
+    mPrev.resize(node_size);
+    mNext.resize(node_size);
+    mClass.resize(node_size);
+    mKey.resize(node_size);
+  }
+  mIn.clear();
+  mIn.resize(node_size, false);
+  mNum = 0;
+}
+
+// @brief ノードを追加する．
+inline
+void
+MisBucket::put(
+  SizeType id,
+  SizeType cls,
+  SizeType key
+)
+{
+  ASSERT_COND( !mIn[id] );
+  ASSERT_COND( key <= mMaxKey );
+
+  mIn[id] = true;
+  mClass[id] = cls;
+  mKey[id] = key;
+  link(id);
+  ++ mNum;
+}
+
+// @brief ノードを取り除く．
+inline
+void
+MisBucket::erase(
+  SizeType id
+)
+{
+  ASSERT_COND( mIn[id] );
+
+  unlink(id);
+  mIn[id] = false;
+  -- mNum;
+}
+
+// @brief ノードのキーを1つ減らす．
+inline
+void
+MisBucket::dec_key(
+  SizeType id
+)
+{
+  ASSERT_COND( mIn[id] );
+  ASSERT_COND( mKey[id] > 0 );
+
+  unlink(id);
+  -- mKey[id];
+  link(id);
+}
+
+// @brief クラスの中でキーが最小のノードを返す．
+inline
+SizeType
+MisBucket::min_node(
+  SizeType cls
+)
+{
+  auto& min_key = mMinKey[cls];
+  while ( min_key <= mMaxKey ) {
+    auto id = mHead[bucket(cls, min_key)];
+    if ( id != BAD_ID ) {
+      return id;
+    }
+    ++ min_key;
+  }
+  return BAD_ID;
+}
+
+// @brief ノードをバケツにつなぐ．
+inline
+void
+MisBucket::link(
+  SizeType id
+)
+{
+  auto cls = mClass[id];
+  auto key = mKey[id];
+  auto& head = mHead[bucket(cls, key)];
+  mPrev[id] = BAD_ID;
+  mNext[id] = head;
+  if ( head != BAD_ID ) {
+    mPrev[head] = id;
+  }
+  head = id;
+  if ( mMinKey[cls] > key ) {
+    mMinKey[cls] = key;
+  }
+}
+
+// @brief ノードをバケツから外す．
+inline
+void
+MisBucket::unlink(
+  SizeType id
+)
+{
+  auto prev = mPrev[id];
+  auto next = mNext[id];
+  if ( prev != BAD_ID ) {
+    mNext[prev] = next;
+  }
+  else {
+    mHead[bucket(mClass[id], mKey[id])] = next;
+  }
+  if ( next != BAD_ID ) {
+    mPrev[next] = prev;
+  }
+}
+
+END_NAMESPACE_YM_MINCOV
+
+#endif // MISBUCKET_H
@@ -0,0 +1,179 @@
+
+/// @file MwisSolver.cc
+/// @brief MwisSolver の実装ファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "MwisSolver.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+// クラス MwisSolver
+//////////////////////////////////////////////////////////////////////
+
+// @brief 初期化する．
+void
+MwisSolver::init(
+  SizeType node_num
+)
+{
+  mNodeNum = node_num;
+  mWordNum = (node_num + 63) / 64;
+  mWeight.clear();
+  mWeight.resize(node_num, 0);
+  mAdj.clear();
+  mAdj.resize(node_num * mWordNum, 0);
+  mTmp1.resize(mWordNum);
+  mTmp2.resize(mWordNum);
+}
+
+// @brief 重み付き最大独立集合を求める．
+int
+MwisSolver::solve(
+  int lower,
+  int target,
+  SizeType node_limit,
+  const std::atomic<bool>* cancel_flag
+)
+{
+  mBest = lower;
+  mTarget = target;
+  mNodeLimit = node_limit;
+  mCancelFlag = cancel_flag;
+  mSearchNum = 0;
+  mOptimal = true;
+  if ( mNodeNum == 0 || mBest >= mTarget ) {
+    return mBest;
+  }
+
+  // 深さは高々ノード数なので先に確保しておく．
+  // 再帰の途中で確保し直すと上位の参照が無効になる．
+  if ( mCandPool.size() < (mNodeNum + 1) * mWordNum ) {
+    mCandPool.resize((mNodeNum + 1) * mWordNum);
+  }
+  if ( mOrderPool.size() < mNodeNum + 1 ) {
+    mOrderPool.resize(mNodeNum + 1);
+    mBoundPool.resize(mNodeNum + 1);
+  }
+  auto p = cand(0);
+  for ( SizeType i = 0; i < mWordNum; ++ i ) {
+    p[i] = ~static_cast<std::uint64_t>(0);
+  }
+  if ( mNodeNum % 64 ) {
+    p[mWordNum - 1] = bit(mNodeNum) - 1;
+  }
+  expand(0, 0);
+  return mBest;
+}
+
+// @brief 候補集合から独立集合を広げる．
+void
+MwisSolver::expand(
+  SizeType depth,
+  int cur_weight
+)
+{
+  // 途中の集合も独立集合なので打ち切られても解として使える．
+  if ( mBest < cur_weight ) {
+    mBest = cur_weight;
+  }
+  ++ mSearchNum;
+  if ( mSearchNum > mNodeLimit ||
+       (mCancelFlag != nullptr &&
+	mCancelFlag->load(std::memory_order_relaxed)) ) {
+    mOptimal = false;
+    return;
+  }
+
+  partition(depth);
+  auto& order = mOrderPool[depth];
+  auto& bound = mBoundPool[depth];
+  // 上界の大きい方から分岐する．
+  // 分岐し終えたノードは候補から外すので，
+  // 残りの候補の上界は bound[i] で抑えられる．
+  for ( SizeType i = order.size(); i -- > 0; ) {
+    if ( cur_weight + bound[i] <= mBest ) {
+      return;
+    }
+    auto id = order[i];
+    auto weight = cur_weight + mWeight[id];
+    auto p = cand(depth);
+    auto q = cand(depth + 1);
+    auto adj = &mAdj[id * mWordNum];
+    p[id / 64] &= ~bit(id);
+    bool empty = true;
+    for ( SizeType j = 0; j < mWordNum; ++ j ) {
+      q[j] = p[j] & ~adj[j];
+      if ( q[j] ) {
+	empty = false;
+      }
+    }
+    if ( empty ) {
+      if ( mBest < weight ) {
+	mBest = weight;
+      }
+    }
+    else {
+      expand(depth + 1, weight);
+    }
+    if ( !mOptimal || mBest >= mTarget ) {
+      return;
+    }
+  }
+}
+
+// @brief 候補集合をクリークに分割する．
+void
+MwisSolver::partition(
+  SizeType depth
+)
+{
+  auto& order = mOrderPool[depth];
+  auto& bound = mBoundPool[depth];
+  order.clear();
+  bound.clear();
+
+  // rest: まだクリークに入っていない候補
+  // cands: 今作っているクリークに加えられる候補
+  auto rest = &mTmp1[0];
+  auto cands = &mTmp2[0];
+  auto p = cand(depth);
+  for ( SizeType j = 0; j < mWordNum; ++ j ) {
+    rest[j] = p[j];
+  }
+  int ub = 0;
+  for ( SizeType j0 = 0; j0 < mWordNum; ) {
+    if ( rest[j0] == 0 ) {
+      ++ j0;
+      continue;
+    }
+    // 新しいクリークを作る．
+    for ( SizeType j = j0; j < mWordNum; ++ j ) {
+      cands[j] = rest[j];
+    }
+    int max_weight = 0;
+    for ( SizeType j = j0; j < mWordNum; ) {
+      if ( cands[j] == 0 ) {
+	++ j;
+	continue;
+      }
+      SizeType id = j * 64 + __builtin_ctzll(cands[j]);
+      order.push_back(id);
+      max_weight = std::max(max_weight, mWeight[id]);
+      rest[j] &= ~bit(id);
+      // クリークに加えられるのはすべてのメンバに隣接しているノード
+      auto adj = &mAdj[id * mWordNum];
+      for ( SizeType k = j; k < mWordNum; ++ k ) {
+	cands[k] &= adj[k];
+      }
+    }
+    ub += max_weight;
+    bound.resize(order.size(), ub);
+  }
+}
+
+END_NAMESPACE_YM_MINCOV
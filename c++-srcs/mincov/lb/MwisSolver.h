@@ -0,0 +1,200 @@
+#ifndef MWISSOLVER_H
+#define MWISSOLVER_H
+
+/// @file MwisSolver.h
+/// @brief MwisSolver のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "mincov/mincov_nsdef.h"
+#include <atomic>
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+/// @class MwisSolver MwisSolver.h "MwisSolver.h"
+/// @brief 重み付き最大独立集合を求めるクラス
+///
+/// 補グラフ上の重み付き最大クリークと同じ問題を分枝限定法で解く．
+///
+/// * 隣接関係と候補集合はビットベクタで表す．
+/// * 上界は候補集合をクリークに分割して求める．
+///   1つのクリークからは高々1つのノードしか選べないので，
+///   各クリークの最大の重みの和が上界となる．
+/// * 探索ノード数の上限を超えたらそれまでの最良解で打ち切る．
+///   得られた集合は常に独立集合なので，値は下界として使える．
+//////////////////////////////////////////////////////////////////////
+class MwisSolver
+{
+public:
+
+  /// @brief コンストラクタ
+  MwisSolver() = default;
+
+  /// @brief デストラクタ
+  ~MwisSolver() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 初期化する．
+  ///
+  /// 枝を持たないグラフとなる．
+  void
+  init(
+    SizeType node_num ///< [in] ノード数
+  );
+
+  /// @brief ノードの重みを設定する．
+  void
+  set_weight(
+    SizeType id, ///< [in] ノード番号 ( 0 <= id < node_num )
+    int weight   ///< [in] 重み ( > 0 )
+  )
+  {
+    mWeight[id] = weight;
+  }
+
+  /// @brief 2つのノードを隣接させる．
+  void
+  connect(
+    SizeType id1, ///< [in] ノード番号1
+    SizeType id2  ///< [in] ノード番号2
+  )
+  {
+    mAdj[id1 * mWordNum + id2 / 64] |= bit(id2);
+    mAdj[id2 * mWordNum + id1 / 64] |= bit(id1);
+  }
+
+  /// @brief 重み付き最大独立集合を求める．
+  /// @return 得られた独立集合の重みの和と lower の大きい方を返す．
+  ///
+  /// lower より重い独立集合だけを探す．
+  /// target 以上の重みの独立集合が見つかるか，
+  /// 探索ノード数が node_limit を超えるか，
+  /// cancel_flag が立ったらそこで打ち切る．
+  int
+  solve(
+    int lower,                           ///< [in] 既知の独立集合の重み
+    int target,                          ///< [in] 目標値
+    SizeType node_limit,                 ///< [in] 探索ノード数の上限
+    const std::atomic<bool>* cancel_flag ///< [in] 打ち切りフラグ
+  );
+
+  /// @brief 直前の solve() で探索したノード数を返す．
+  SizeType
+  search_num() const
+  {
+    return mSearchNum;
+  }
+
+  /// @brief 直前の solve() が打ち切られずに終わった時 true を返す．
+  bool
+  is_optimal() const
+  {
+    return mOptimal;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 1ビットだけ立ったワードを返す．
+  static
+  std::uint64_t
+  bit(
+    SizeType id
+  )
+  {
+    return static_cast<std::uint64_t>(1) << (id % 64);
+  }
+
+  /// @brief 候補集合から独立集合を広げる．
+  ///
+  /// 候補集合は mCandPool の depth 番目に入っている．
+  void
+  expand(
+    SizeType depth, ///< [in] 深さ
+    int cur_weight  ///< [in] 現在の独立集合の重み
+  );
+
+  /// @brief 候補集合をクリークに分割する．
+  ///
+  /// 結果は mOrderPool[depth] と mBoundPool[depth] に入る．
+  void
+  partition(
+    SizeType depth ///< [in] 深さ
+  );
+
+  /// @brief depth 番目の候補集合の先頭を返す．
+  std::uint64_t*
+  cand(
+    SizeType depth
+  )
+  {
+    return &mCandPool[depth * mWordNum];
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // ノード数
+  SizeType mNodeNum{0};
+
+  // 1つのビットベクタのワード数
+  SizeType mWordNum{0};
+
+  // ノードごとの重み
+  vector<int> mWeight;
+
+  // ノードごとの隣接ノードのビットベクタ
+  // サイズは mNodeNum * mWordNum
+  vector<std::uint64_t> mAdj;
+
+  // 深さごとの候補集合
+  vector<std::uint64_t> mCandPool;
+
+  // 深さごとの分岐するノードの順番
+  vector<vector<SizeType>> mOrderPool;
+
+  // 深さごとの mOrderPool の各位置までの上界
+  vector<vector<int>> mBoundPool;
+
+  // クリーク分割で用いる作業領域
+  vector<std::uint64_t> mTmp1;
+  vector<std::uint64_t> mTmp2;
+
+  // 最良解の重み
+  int mBest{0};
+
+  // 目標値
+  int mTarget{0};
+
+  // 探索ノード数の上限
+  SizeType mNodeLimit{0};
+
+  // 打ち切りフラグ
+  const std::atomic<bool>* mCancelFlag{nullptr};
+
+  // 探索したノード数
+  SizeType mSearchNum{0};
+
+  // 打ち切られなかった時 true
+  bool mOptimal{false};
+
+};
+
+END_NAMESPACE_YM_MINCOV
+
+#endif // MWISSOLVER_H
@@ -3,7 +3,7 @@
 /// @brief SelCS の実装ファイル
 /// @author Yusuke Matsunaga (松永 裕介)
 ///
-/// Copyright (C) 2014, 2022 Yusuke Matsunaga
+/// Copyright (C) 2014, 2022, 2025 Yusuke Matsunaga
 /// All rights reserved.
 
 #include "SelCS.h"
@@ -24,74 +24,179 @@ SelCS::select(
 {
   // 各行にカバーしている列数に応じた重みをつけ，
   // その重みの和が最大となる列を選ぶ．
-  SizeType nr = matrix.row_size();
-  vector<double> row_weights(nr);
-  for ( auto row_pos: matrix.row_head_list() ) {
-    double min_cost = DBL_MAX;
-    for ( auto col_pos: matrix.row_list(row_pos) ) {
-      double col_cost = static_cast<double>(matrix.col_cost(col_pos)) / matrix.col_elem_num(col_pos);
-      if ( min_cost > col_cost ) {
-	min_cost = col_cost;
-      }
-    }
-    row_weights[row_pos] = min_cost;
-  }
+  update_weights(matrix);
 
+  // 増分が無限大になる列しかない時でもアクティブな列を返すように
+  // 最初の列は無条件に選んでおく．
   double min_delta = DBL_MAX;
   SizeType min_col = 0;
-  for ( auto col_pos: matrix.col_head_list() ) {
-    double col_cost = matrix.col_cost(col_pos);
-
-    vector<SizeType> col_delta(matrix.col_size(), 0);
-    vector<SizeType> col_list;
-    for ( auto row_pos: matrix.col_list(col_pos) ) {
-      for ( auto col_pos1: matrix.row_list(row_pos) ) {
-	if ( col_delta[col_pos1] == 0 ) {
-	  col_list.push_back(col_pos1);
+  bool first = true;
+  matrix.with_lists([&](const auto& lists) {
+    for ( auto col_pos: matrix.col_head_list() ) {
+      // col_pos の行を共有する列ごとに共有する行数を数える．
+      new_epoch();
+      for ( auto row_pos: lists.col_list(col_pos) ) {
+	for ( auto col_pos1: lists.row_list(row_pos) ) {
+	  if ( mColEpoch[col_pos1] != mEpoch ) {
+	    mColEpoch[col_pos1] = mEpoch;
+	    mColDelta[col_pos1] = 0;
+	  }
+	  ++ mColDelta[col_pos1];
 	}
-	++ col_delta[col_pos1];
       }
-    }
 
-    vector<bool> row_mark(matrix.row_size(), false);
-    vector<SizeType> row_list;
-    for ( auto col_pos1: col_list ) {
-      double cost1 = matrix.col_cost(col_pos1);
-      SizeType num = matrix.col_elem_num(col_pos1);
-      cost1 /= num;
-      for ( auto row_pos: matrix.col_list(col_pos) ) {
-	if ( row_weights[row_pos] < cost1 ) {
-	  continue;
-	}
-	if ( row_mark[row_pos] ) {
-	  continue;
+      // col_pos を選んだ時の col_pos の各行の重みの増分を求める．
+      // 行の重みはその行の列の中の最小値なので，
+      // col_pos の行はどれも重みを与える列を共有している．
+      double delta_sum = 0.0;
+      for ( auto row_pos: lists.col_list(col_pos) ) {
+	double min_weight = DBL_MAX;
+	for ( auto col_pos1: lists.row_list(row_pos) ) {
+	  double n = matrix.col_elem_num(col_pos1) - mColDelta[col_pos1];
+	  double cost1 = matrix.col_cost(col_pos1) / n;
+	  if ( min_weight > cost1 ) {
+	    min_weight = cost1;
+	  }
 	}
-	row_mark[row_pos] = true;
-	row_list.push_back(row_pos);
+	double delta = min_weight - mRowWeight[row_pos];
+	delta_sum += delta;
+      }
+
+      if ( first || min_delta > delta_sum ) {
+	min_delta = delta_sum;
+	min_col = col_pos;
+	first = false;
       }
     }
+  });
+  return min_col;
+}
 
-    double delta_sum = 0.0;
-    for ( auto row_pos: row_list ) {
-      double min_weight = DBL_MAX;
-      for ( auto col_pos1: matrix.row_list(row_pos) ) {
-	double n = matrix.col_elem_num(col_pos1) - col_delta[col_pos1];
-	double cost1 = matrix.col_cost(col_pos1) / n;
-	if ( min_weight > cost1 ) {
-	  min_weight = cost1;
+// @brief 行が削除された時に呼ばれる関数
+void
+SelCS::rows_deleted(
+  const vector<SizeType>& row_list
+)
+{
+  for ( auto row_pos: row_list ) {
+    add_dirty_row(row_pos);
+  }
+}
+
+// @brief 列が削除された時に呼ばれる関数
+void
+SelCS::cols_deleted(
+  const vector<SizeType>& col_list
+)
+{
+  for ( auto col_pos: col_list ) {
+    add_dirty_col(col_pos);
+  }
+}
+
+// @brief 行が復元された時に呼ばれる関数
+void
+SelCS::rows_restored(
+  const vector<SizeType>& row_list
+)
+{
+  for ( auto row_pos: row_list ) {
+    add_dirty_row(row_pos);
+  }
+}
+
+// @brief 列が復元された時に呼ばれる関数
+void
+SelCS::cols_restored(
+  const vector<SizeType>& col_list
+)
+{
+  for ( auto col_pos: col_list ) {
+    add_dirty_col(col_pos);
+  }
+}
+
+// @brief 行の重みを最新の状態にする．
+void
+SelCS::update_weights(
+  const McMatrix& matrix
+)
+{
+  if ( observed_matrix() != &matrix ) {
+    // 初めての行列なのですべての行の重みを計算する．
+    attach(matrix);
+    SizeType nr = matrix.row_size();
+    SizeType nc = matrix.col_size();
+    mRowWeight.clear();
+    mRowWeight.resize(nr, 0.0);
+    mDirtyRowList.clear();
+    mRowDirty.clear();
+    mRowDirty.resize(nr, false);
+    mDirtyColList.clear();
+    mColDirty.clear();
+    mColDirty.resize(nc, false);
+    mEpoch = 0;
+    mRowEpoch.clear();
+    mRowEpoch.resize(nr, 0);
+    mColEpoch.clear();
+    mColEpoch.resize(nc, 0);
+    mColDelta.resize(nc);
+    matrix.with_lists([&](const auto& lists) {
+      for ( auto row_pos: matrix.row_head_list() ) {
+	mRowWeight[row_pos] = calc_weight(matrix, lists, row_pos);
+      }
+    });
+    return;
+  }
+
+  // 重みが変わりうるのは以下の行
+  // - 復元された行
+  // - 要素数の変わった列(削除/復元された行の列)の行
+  // - 削除/復元された列の行
+  // 削除された行や列も削除された時点の要素のリストをたどれる．
+  matrix.with_lists([&](const auto& lists) {
+    new_epoch();
+    for ( auto row_pos: mDirtyRowList ) {
+      mRowDirty[row_pos] = false;
+      for ( auto col_pos: lists.row_list(row_pos) ) {
+	add_dirty_col(col_pos);
+      }
+      if ( !matrix.row_deleted(row_pos) ) {
+	mRowEpoch[row_pos] = mEpoch;
+	mRowWeight[row_pos] = calc_weight(matrix, lists, row_pos);
+      }
+    }
+    mDirtyRowList.clear();
+    for ( auto col_pos: mDirtyColList ) {
+      mColDirty[col_pos] = false;
+      for ( auto row_pos: lists.col_list(col_pos) ) {
+	if ( mRowEpoch[row_pos] != mEpoch && !matrix.row_deleted(row_pos) ) {
+	  mRowEpoch[row_pos] = mEpoch;
+	  mRowWeight[row_pos] = calc_weight(matrix, lists, row_pos);
 	}
       }
-      double delta = min_weight - row_weights[row_pos];
-      delta_sum += delta;
     }
+  });
+  mDirtyColList.clear();
+}
 
-    //cout << "Col#" << col->pos() << ": " << delta_sum << endl;
-    if ( min_delta > delta_sum ) {
-      min_delta = delta_sum;
-      min_col = col_pos;
+// @brief 行の重みを計算する．
+template<class Lists>
+double
+SelCS::calc_weight(
+  const McMatrix& matrix,
+  const Lists& lists,
+  SizeType row_pos
+) const
+{
+  double min_cost = DBL_MAX;
+  for ( auto col_pos: lists.row_list(row_pos) ) {
+    double col_cost = static_cast<double>(matrix.col_cost(col_pos)) / matrix.col_elem_num(col_pos);
+    if ( min_cost > col_cost ) {
+      min_cost = col_cost;
     }
   }
-  return min_col;
+  return min_cost;
 }
 
 END_NAMESPACE_YM_MINCOV
@@ -5,10 +5,11 @@
 /// @brief SelCS のヘッダファイル
 /// @author Yusuke Matsunaga (松永 裕介)
 ///
-/// Copyright (C) 2014 Yusuke Matsunaga
+/// Copyright (C) 2014, 2025 Yusuke Matsunaga
 /// All rights reserved.
 
 #include "mincov/Selector.h"
+#include "mincov/McObserver.h"
 
 
 BEGIN_NAMESPACE_YM_MINCOV
@@ -19,9 +20,17 @@ BEGIN_NAMESPACE_YM_MINCOV
 ///
 /// 各行にカバーしている列数に応じた重みをつけ，
 /// その重みの和が最大となる列を選ぶ．
+///
+/// * 行の重みはその行の列の「コスト / 要素数」の最小値(LbCS と同じもの)
+/// * 列を選んだ時の各行の重みの増分の和が最小となる列を選ぶ．
+/// * 行の重みは呼び出しをまたいで保持しておき，
+///   McObserver として通知された行と列の近傍の行だけ計算し直す．
+/// * 列ごとの計算で用いる作業領域は世代番号つきの配列で表し，
+///   列ごとに確保やクリアを行わない．
 //////////////////////////////////////////////////////////////////////
 class SelCS :
-  public Selector
+  public Selector,
+  public McObserver
 {
 public:
   //////////////////////////////////////////////////////////////////////
@@ -35,6 +44,125 @@ public:
     const McMatrix& matrix ///< [in] 対象の行列
   ) override;
 
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // McObserver の仮想関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 行が削除された時に呼ばれる関数
+  void
+  rows_deleted(
+    const vector<SizeType>& row_list ///< [in] 削除された行番号のリスト
+  ) override;
+
+  /// @brief 列が削除された時に呼ばれる関数
+  void
+  cols_deleted(
+    const vector<SizeType>& col_list ///< [in] 削除された列番号のリスト
+  ) override;
+
+  /// @brief 行が復元された時に呼ばれる関数
+  void
+  rows_restored(
+    const vector<SizeType>& row_list ///< [in] 復元された行番号のリスト
+  ) override;
+
+  /// @brief 列が復元された時に呼ばれる関数
+  void
+  cols_restored(
+    const vector<SizeType>& col_list ///< [in] 復元された列番号のリスト
+  ) override;
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // 内部で用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 行の重みを最新の状態にする．
+  void
+  update_weights(
+    const McMatrix& matrix ///< [in] 対象の行列
+  );
+
+  /// @brief 行の重みを計算する．
+  ///
+  /// Lists は McMatrix::with_lists() が渡すもの
+  template<class Lists>
+  double
+  calc_weight(
+    const McMatrix& matrix, ///< [in] 対象の行列
+    const Lists& lists,     ///< [in] matrix のリストの取り出し方
+    SizeType row_pos        ///< [in] 行番号
+  ) const;
+
+  /// @brief 世代番号を進める．
+  void
+  new_epoch()
+  {
+    ++ mEpoch;
+  }
+
+  /// @brief 変化した行を記録する．
+  void
+  add_dirty_row(
+    SizeType row_pos ///< [in] 行番号
+  )
+  {
+    if ( !mRowDirty[row_pos] ) {
+      mRowDirty[row_pos] = true;
+      mDirtyRowList.push_back(row_pos);
+    }
+  }
+
+  /// @brief 変化した列を記録する．
+  void
+  add_dirty_col(
+    SizeType col_pos ///< [in] 列番号
+  )
+  {
+    if ( !mColDirty[col_pos] ) {
+      mColDirty[col_pos] = true;
+      mDirtyColList.push_back(col_pos);
+    }
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 行ごとの重み
+  vector<double> mRowWeight;
+
+  // 前回の select() 以降に削除/復元された行のリスト
+  vector<SizeType> mDirtyRowList;
+
+  // 行ごとの mDirtyRowList に含まれている印
+  vector<bool> mRowDirty;
+
+  // 前回の select() 以降に削除/復元された列のリスト
+  vector<SizeType> mDirtyColList;
+
+  // 列ごとの mDirtyColList に含まれている印
+  vector<bool> mColDirty;
+
+  // 現在の世代番号
+  SizeType mEpoch{0};
+
+  // 行ごとの世代番号
+  // 重みを計算し直す行に印をつけるのに用いる．
+  vector<SizeType> mRowEpoch;
+
+  // 列ごとの世代番号
+  // mColDelta の値はこれが mEpoch と等しい時だけ有効
+  vector<SizeType> mColEpoch;
+
+  // 列ごとの選んだ列と共有する行数
+  vector<SizeType> mColDelta;
+
 };
 
 END_NAMESPACE_YM_MINCOV
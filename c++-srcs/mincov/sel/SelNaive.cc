@@ -34,4 +34,14 @@ SelNaive::select(
   return max_col;
 }
 
+// @brief 列の評価値を返す．
+double
+SelNaive::score(
+  const McMatrix& matrix,
+  SizeType col_pos
+) const
+{
+  return matrix.col_elem_num(col_pos);
+}
+
 END_NAMESPACE_YM_MINCOV
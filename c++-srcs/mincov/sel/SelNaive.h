@@ -35,6 +35,20 @@ public:
     const McMatrix& matrix ///< [in] 対象の行列
   ) override;
 
+  /// @brief 列ごとの評価値を持つ時 true を返す．
+  bool
+  has_score() const override
+  {
+    return true;
+  }
+
+  /// @brief 列の評価値を返す．
+  double
+  score(
+    const McMatrix& matrix, ///< [in] 対象の行列
+    SizeType col_pos        ///< [in] 列番号
+  ) const override;
+
 };
 
 END_NAMESPACE_YM_MINCOV
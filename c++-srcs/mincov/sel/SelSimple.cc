@@ -22,18 +22,10 @@ SelSimple::select(
   const McMatrix& matrix
 )
 {
-  // 各行にカバーしている列数に応じた重みをつけ，
-  // その重みの和が最大となる列を選ぶ．
   double max_weight = 0.0;
   SizeType max_col = 0;
   for ( auto col_pos: matrix.col_head_list() ) {
-    double weight = 0.0;
-    for ( auto row_pos: matrix.col_list(col_pos) ) {
-      double num = matrix.row_elem_num(row_pos);
-      weight += (1.0 / (num - 1.0));
-    }
-    weight /= matrix.col_cost(col_pos);
-
+    double weight = score(matrix, col_pos);
     if ( max_weight < weight ) {
       max_weight = weight;
       max_col = col_pos;
@@ -42,4 +34,23 @@ SelSimple::select(
   return max_col;
 }
 
+// @brief 列の評価値を返す．
+double
+SelSimple::score(
+  const McMatrix& matrix,
+  SizeType col_pos
+) const
+{
+  // 各行にカバーしている列数に応じた重みをつけ，
+  // その重みの和をコストで割ったもの
+  double weight = 0.0;
+  matrix.with_lists([&](const auto& lists) {
+    for ( auto row_pos: lists.col_list(col_pos) ) {
+      double num = matrix.row_elem_num(row_pos);
+      weight += (1.0 / (num - 1.0));
+    }
+  });
+  return weight / matrix.col_cost(col_pos);
+}
+
 END_NAMESPACE_YM_MINCOV
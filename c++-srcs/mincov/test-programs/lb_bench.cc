@@ -0,0 +1,158 @@
+
+/// @file lb_bench.cc
+/// @brief 下界の計算方法による厳密解法の探索ノード数を比較するプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/MinCov.h"
+#include "ym/JsonValue.h"
+#include "mincov/McMatrix.h"
+#include "mincov/LbCalc.h"
+#include "ym/Timer.h"
+#include <random>
+#include <libgen.h>
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+void
+usage(
+  char* arg0
+)
+{
+  cerr << "Usage: " << basename(arg0)
+       << " [--root] <row_size> <col_size> <density(%)> <max_cost> <instance_num> [<seed>]" << endl
+       << "  --root: measure a single calc() at the root instead of the exact solve" << endl;
+}
+
+// 根の行列で1回だけ下界を計算した時の時間と値を出力する．
+//
+// max_cost を大きくするとコストの種類の多い場合を測れる．
+void
+root_bench(
+  const vector<MinCov>& instance_list
+)
+{
+  for ( auto type: {"CS", "MIS1", "MIS2", "MIS3", "LAGRANGE", "DUAL"} ) {
+    std::unordered_map<string, JsonValue> lb_dict;
+    lb_dict.emplace("type", JsonValue{type});
+    auto lb_calc = LbCalc::new_obj(JsonValue{lb_dict});
+
+    double total_time = 0.0;
+    SizeType total_lb = 0;
+    for ( auto& mincov: instance_list ) {
+      McMatrix matrix{mincov.row_size(), mincov.col_cost_array(),
+		      mincov.elem_list()};
+      Timer timer;
+      timer.start();
+      total_lb += lb_calc->calc(matrix);
+      timer.stop();
+      total_time += timer.get_time();
+    }
+    cout << " " << type << ": "
+	 << total_time << "(ms)"
+	 << ", total lower bound = " << total_lb << endl;
+  }
+}
+
+int
+lb_bench(
+  int argc,
+  char** argv
+)
+{
+  bool root = false;
+  int base = 1;
+  if ( base < argc && string{argv[base]} == "--root" ) {
+    root = true;
+    ++ base;
+  }
+  if ( argc - base != 5 && argc - base != 6 ) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  SizeType row_size = std::stoul(argv[base + 0]);
+  SizeType col_size = std::stoul(argv[base + 1]);
+  SizeType density = std::stoul(argv[base + 2]);
+  SizeType max_cost = std::stoul(argv[base + 3]);
+  SizeType instance_num = std::stoul(argv[base + 4]);
+  SizeType seed = 0;
+  if ( argc - base == 6 ) {
+    seed = std::stoul(argv[base + 5]);
+  }
+
+  // 全ての下界で同じ問題の集合を用いる．
+  // 各行は少なくとも1つの要素を持つ．
+  std::mt19937 randgen(seed);
+  std::uniform_int_distribution<SizeType> rd_col(0, col_size - 1);
+  std::uniform_int_distribution<SizeType> rd_cost(1, max_cost);
+  std::uniform_int_distribution<SizeType> rd_pct(0, 99);
+  vector<MinCov> instance_list;
+  for ( SizeType i = 0; i < instance_num; ++ i ) {
+    vector<SizeType> cost_array(col_size);
+    for ( auto& cost: cost_array ) {
+      cost = rd_cost(randgen);
+    }
+    MinCov mincov{row_size, cost_array};
+    for ( SizeType row_pos = 0; row_pos < row_size; ++ row_pos ) {
+      mincov.insert_elem(row_pos, rd_col(randgen));
+      for ( SizeType col_pos = 0; col_pos < col_size; ++ col_pos ) {
+	if ( rd_pct(randgen) < density ) {
+	  mincov.insert_elem(row_pos, col_pos);
+	}
+      }
+    }
+    instance_list.push_back(std::move(mincov));
+  }
+
+  cout << instance_num << " instances of "
+       << row_size << " x " << col_size << ", density "
+       << density << "%, cost 1 - " << max_cost << endl;
+
+  if ( root ) {
+    root_bench(instance_list);
+    return 0;
+  }
+
+  for ( auto type: {"CS", "MIS1", "MIS2", "MIS3", "LAGRANGE", "DUAL"} ) {
+    std::unordered_map<string, JsonValue> lb_dict;
+    lb_dict.emplace("type", JsonValue{type});
+    std::unordered_map<string, JsonValue> opt_dict;
+    opt_dict.emplace("algorithm", JsonValue{"exact"});
+    opt_dict.emplace("lower_bound", JsonValue{lb_dict});
+    auto option = JsonValue{opt_dict};
+
+    Timer timer;
+    timer.start();
+    SizeType total_cost = 0;
+    SizeType total_node = 0;
+    for ( auto& mincov: instance_list ) {
+      vector<SizeType> solution;
+      MinCov::Result result;
+      total_cost += mincov.solve(solution, option, result);
+      total_node += result.node_num;
+    }
+    timer.stop();
+    cout << " " << type << ": "
+	 << total_node << " nodes, "
+	 << timer.get_time() / 1000.0 << "(s)"
+	 << ", total cost = " << total_cost << endl;
+  }
+
+  return 0;
+}
+
+END_NAMESPACE_YM_MINCOV
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return nsYm::nsMincov::lb_bench(argc, argv);
+}
@@ -0,0 +1,126 @@
+
+/// @file mincov_bench.cc
+/// @brief MinCov の厳密解法のスレッド数によるスケーリングを計測するプログラム
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "ym/MinCov.h"
+#include "ym/JsonValue.h"
+#include "ym/Timer.h"
+#include <random>
+#include <libgen.h>
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+void
+usage(
+  char* arg0
+)
+{
+  cerr << "Usage: " << basename(arg0)
+       << " [--partition] <row_size> <col_size> <density(%)> <instance_num> [<seed>]" << endl;
+}
+
+int
+mincov_bench(
+  int argc,
+  char** argv
+)
+{
+  bool partition = false;
+  int base = 1;
+  for ( ; base < argc; ++ base ) {
+    auto opt = string{argv[base]};
+    if ( opt == "--partition" ) {
+      partition = true;
+    }
+    else {
+      break;
+    }
+  }
+  if ( argc - base != 4 && argc - base != 5 ) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  SizeType row_size = std::stoul(argv[base + 0]);
+  SizeType col_size = std::stoul(argv[base + 1]);
+  SizeType density = std::stoul(argv[base + 2]);
+  SizeType instance_num = std::stoul(argv[base + 3]);
+  SizeType seed = 0;
+  if ( argc - base == 5 ) {
+    seed = std::stoul(argv[base + 4]);
+  }
+
+  // 全てのスレッド数で同じ問題の集合を用いる．
+  // 各行は少なくとも1つの要素を持つ．
+  std::mt19937 randgen(seed);
+  std::uniform_int_distribution<SizeType> rd_col(0, col_size - 1);
+  std::uniform_int_distribution<SizeType> rd_cost(1, 3);
+  std::uniform_int_distribution<SizeType> rd_pct(0, 99);
+  vector<MinCov> instance_list;
+  for ( SizeType i = 0; i < instance_num; ++ i ) {
+    vector<SizeType> cost_array(col_size);
+    for ( auto& cost: cost_array ) {
+      cost = rd_cost(randgen);
+    }
+    MinCov mincov{row_size, cost_array};
+    for ( SizeType row_pos = 0; row_pos < row_size; ++ row_pos ) {
+      mincov.insert_elem(row_pos, rd_col(randgen));
+      for ( SizeType col_pos = 0; col_pos < col_size; ++ col_pos ) {
+	if ( rd_pct(randgen) < density ) {
+	  mincov.insert_elem(row_pos, col_pos);
+	}
+      }
+    }
+    instance_list.push_back(std::move(mincov));
+  }
+
+  cout << instance_num << " instances of "
+       << row_size << " x " << col_size << ", density "
+       << density << "%"
+       << (partition ? " (partition)" : "") << endl;
+
+  double base_time = 0.0;
+  for ( int thread_num: {1, 2, 4, 8, 16} ) {
+    std::unordered_map<string, JsonValue> opt_dict;
+    opt_dict.emplace("algorithm", JsonValue{"exact"});
+    opt_dict.emplace("threads", JsonValue{thread_num});
+    opt_dict.emplace("partition", JsonValue{partition});
+    auto option = JsonValue{opt_dict};
+
+    Timer timer;
+    timer.start();
+    SizeType total_cost = 0;
+    for ( auto& mincov: instance_list ) {
+      vector<SizeType> solution;
+      total_cost += mincov.solve(solution, option);
+    }
+    timer.stop();
+    double time = timer.get_time() / 1000.0;
+    if ( thread_num == 1 ) {
+      base_time = time;
+    }
+    cout << " threads = " << thread_num
+	 << ": " << time << "(s)"
+	 << ", speedup = " << (time > 0.0 ? base_time / time : 0.0)
+	 << ", total cost = " << total_cost << endl;
+  }
+
+  return 0;
+}
+
+END_NAMESPACE_YM_MINCOV
+
+
+int
+main(
+  int argc,
+  char** argv
+)
+{
+  return nsYm::nsMincov::mincov_bench(argc, argv);
+}
@@ -43,6 +43,24 @@ public:
     SizeType col_pos; ///< 列番号
   };
 
+  /// @brief solve() の詳細な結果を表す型
+  ///
+  /// "time_limit_ms" や "node_limit" で探索が打ち切られた時は
+  /// optimal が false になり，lower_bound は解のコストより小さくなりうる．
+  struct Result {
+    SizeType cost{0};        ///< 得られた解のコスト(上界)
+    SizeType lower_bound{0}; ///< 最適解のコストの下界
+    bool optimal{false};     ///< 最適性が証明された時 true
+    SizeType node_num{0};    ///< 探索したノード数
+
+    /// @brief 上界と下界の差を返す．
+    SizeType
+    gap() const
+    {
+      return cost - lower_bound;
+    }
+  };
+
 public:
   //////////////////////////////////////////////////////////////////////
   // コンストラクタ/デストラクタ
@@ -213,9 +231,106 @@ public:
 
   /// @brief 最小被覆問題を解く．
   /// @return 解のコスト
+  ///
+  /// option には以下のキーを指定できる．
+  /// - "algorithm": アルゴリズム名("exact", "greedy" か "multistart")
+  /// - "lazy": true の時は "greedy" で列の評価値を最大ヒープに入れて
+  ///   取り出した列だけを評価し直す(大きな行列向け)．
+  ///   "selector" は "simple" か "naive" でなければならない．
+  /// - "multistart" では乱択を加えた greedy を "starts" 回
+  ///   (デフォルトは 32)行い最良の解を返す．"threads" 個のスレッドで
+  ///   並列に行う．"seed" で乱数の種，"noise" で評価値に加える雑音の
+  ///   大きさ(%)，"rcl" でランダムに選ぶ候補の評価値の範囲(%)を指定できる．
+  ///   "time_limit_ms" を過ぎたら打ち切る．"stats" が true の時は
+  ///   解のコストの分布を出力する．
+  ///   "selector" は "simple" か "naive" でなければならない．
+  /// - "compact": true の時はメモリ使用量の少ない
+  ///   コンパクトモードの行列を用いる．
+  /// - "partition": true の時は厳密解法の分岐の前に行列を
+  ///   独立なブロックに分割して個別に解く．
+  /// - "threads": 厳密解法と "multistart" で用いるスレッド数(デフォルトは 1)
+  ///   ブロックに分割できた時はブロックを並列に解き，
+  ///   そうでなければ部分木を並列に探索する．
+  /// - "primal": 厳密解法で上界を求めるためのヒューリスティックの設定
+  ///   false で無効，true か省略時は根で Greedy を行う．
+  ///   JSON オブジェクトの時は "selector"(オブジェクトか配列)，
+  ///   "root", "interval", "compare" を指定できる．
+  /// - "lower_bound": 厳密解法の下界の計算方法を表すオブジェクト
+  ///   "type" に "CS", "MIS1", "MIS2", "MIS3", "LAGRANGE", "DUAL", "MAX"
+  ///   を指定する．
+  ///   "LAGRANGE" では "root_iter", "max_iter" で劣勾配法の反復回数を指定できる．
+  ///   "MAX" では "child_list" に子供の設定の配列を指定する．
+  ///   "parallel" が true の時は子供を並列に計算し，
+  ///   どれかが枝刈りできる値に達したら残りを打ち切る．
+  ///   子供の計算用のスレッドは "MAX" ごとに作られるので，
+  ///   "threads" が 2 以上の時は指定できない．
+  ///   "MIS3" では "node_limit" で重み付き最大独立集合の探索ノード数の上限を，
+  ///   "max_rows" で探索を行う最大の行数を指定できる．
+  /// - "lb_stats": true の時は下界の計算の統計情報を出力する．
+  ///   "MAX" では子供ごとの計算時間と枝刈りに成功した回数を出力する．
+  /// - "fixing": false の時は下界の計算で得られた被約費用による
+  ///   列の固定を行わない(デフォルトは true)
+  /// - "bit_kernel": 厳密解法でアクティブな行数がこの値以下になった
+  ///   部分問題をビット演算による専用の分枝限定法で解く．
+  ///   (デフォルトは 64，最大 128，0 なら用いない)
+  /// - "tt_size": 厳密解法で同じ部分問題の下界を記録しておく
+  ///   置換表の要素数(デフォルトは 0 で用いない)
+  ///   "lb_stats" が true の時はヒット率を出力する．
+  /// - "time_limit_ms": 厳密解法と "multistart" の制限時間(ミリ秒，0 なら無制限)
+  /// - "node_limit": 厳密解法で探索するノード数の上限(0 なら無制限)
+  /// - "improve": true か JSON オブジェクトの時は得られた解を
+  ///   局所探索で改善する．オブジェクトの内容は improve() と同じ．
+  ///
+  /// 制限に達した時はそれまでに得られた最良の解を返す．
+  SizeType
+  solve(
+    vector<SizeType>& solution, ///< [out] 選ばれた列集合
+    const JsonValue& option     ///< [in] オプションを表すJSONオブジェクト
+  )
+  {
+    Result result;
+    return solve(solution, option, result);
+  }
+
+  /// @brief 最小被覆問題を解いて詳細な結果を得る．
+  /// @return 解のコスト
+  ///
+  /// option は solve(solution, option) と同じ．
   SizeType
   solve(
     vector<SizeType>& solution, ///< [out] 選ばれた列集合
+    const JsonValue& option,    ///< [in] オプションを表すJSONオブジェクト
+    Result& result              ///< [out] 詳細な結果
+  );
+
+  /// @brief 解を局所探索で改善する．
+  /// @return 改善後の解のコスト
+  ///
+  /// solution は被覆解でなければならない(そうでない時は
+  /// std::invalid_argument 例外を送出する)．
+  /// どのアルゴリズムで求めた解でもよい．
+  /// 冗長な列をコストの大きい順に取り除いたあと，
+  /// 1つの列をより安い1つの列に置き換える 1-for-1 交換と
+  /// 2つの列をより安い1つの列に置き換える 2-for-1 交換を
+  /// 改善がなくなるまで繰り返す．
+  /// 元の解に残った列は元の順番のまま，新たに加わった列はその後ろに並ぶ．
+  SizeType
+  improve(
+    vector<SizeType>& solution ///< [inout] 解のリスト
+  );
+
+  /// @brief オプションを指定して解を局所探索で改善する．
+  /// @return 改善後の解のコスト
+  ///
+  /// option には以下のキーを指定できる．
+  /// - "swap1": false の時は 1-for-1 交換を行わない．
+  /// - "swap2": false の時は 2-for-1 交換を行わない．
+  /// - "max_pass": 解全体を調べる回数の上限(デフォルトは 0 で無制限)
+  /// - "time_limit_ms": 制限時間(ミリ秒，0 なら無制限)
+  /// - "stats": true の時は統計情報を出力する．
+  SizeType
+  improve(
+    vector<SizeType>& solution, ///< [inout] 解のリスト
     const JsonValue& option     ///< [in] オプションを表すJSONオブジェクト
   );
 
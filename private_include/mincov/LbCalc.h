@@ -10,6 +10,7 @@
 
 #include "mincov/mincov_nsdef.h"
 #include "ym/json.h"
+#include <atomic>
 
 
 BEGIN_NAMESPACE_YM_MINCOV
@@ -17,6 +18,10 @@ BEGIN_NAMESPACE_YM_MINCOV
 //////////////////////////////////////////////////////////////////////
 /// @class LbCalc LbCalc.h "LbCalc.h"
 /// @brief 下界の計算クラス
+///
+/// 実装によっては前回の calc() の結果(乗数や衝突グラフなど)を保持して
+/// 次の calc() で再利用するので，1つのインスタンスは1つの行列に対して
+/// 用いること．
 //////////////////////////////////////////////////////////////////////
 class LbCalc
 {
@@ -46,6 +51,123 @@ public:
     const McMatrix& matrix ///< [in] 対象の行列
   ) = 0;
 
+  /// @brief 目標値を指定して下界の計算をする
+  ///
+  /// * 下界が target 以上になることがわかった時点で計算を打ち切ってよい．
+  ///   その場合も返り値は正しい下界で，target 以上になる．
+  /// * 打ち切った時は reduced_cost() と relaxed_value() は意味を持たない．
+  /// * デフォルトの実装は calc(matrix) を呼ぶ．
+  virtual
+  int
+  calc(
+    const McMatrix& matrix, ///< [in] 対象の行列
+    int target              ///< [in] 目標値
+  )
+  {
+    return calc(matrix);
+  }
+
+  /// @brief 直前の calc() で求めた列の被約費用を返す．
+  /// @return 被約費用を求めない実装では nullptr を返す．
+  ///
+  /// * ラグランジュ緩和に基づく実装のみが値を返す．
+  /// * 列番号でアクセスする．アクティブでない列の値は意味を持たない．
+  /// * 列 j を選ぶ解のコストは relaxed_value() + (被約費用) 以上になる．
+  virtual
+  const vector<double>*
+  reduced_cost() const
+  {
+    return nullptr;
+  }
+
+  /// @brief 直前の calc() で求めた緩和問題の値を返す．
+  ///
+  /// reduced_cost() が nullptr を返す時は意味を持たない．
+  virtual
+  double
+  relaxed_value() const
+  {
+    return 0.0;
+  }
+
+  /// @brief 計算を打ち切るためのフラグを設定する．
+  ///
+  /// * フラグが立つと calc() は途中でも正しい下界を返して終わる．
+  ///   その場合も reduced_cost() と relaxed_value() は意味を持たない．
+  /// * 反復や探索を行う実装だけがフラグを調べる．
+  /// * nullptr の時は打ち切らない．
+  virtual
+  void
+  set_cancel_flag(
+    const std::atomic<bool>* flag ///< [in] 打ち切りフラグ
+  )
+  {
+    mCancelFlag = flag;
+  }
+
+  /// @brief 自前のスレッドを作って計算する時 true を返す．
+  ///
+  /// デフォルトの実装は false を返す．
+  virtual
+  bool
+  spawns_threads() const
+  {
+    return false;
+  }
+
+  /// @brief 統計情報を出力する．
+  ///
+  /// デフォルトの実装は何もしない．
+  virtual
+  void
+  print_stats(
+    ostream& s ///< [in] 出力先のストリーム
+  ) const
+  {
+  }
+
+  /// @brief 同じ構成の LbCalc の統計情報を足し込む．
+  ///
+  /// デフォルトの実装は何もしない．
+  virtual
+  void
+  merge_stats(
+    const LbCalc& src ///< [in] 足し込む LbCalc
+  )
+  {
+  }
+
+
+
+protected:
+  //////////////////////////////////////////////////////////////////////
+  // 継承クラスから用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 打ち切りフラグを返す．
+  const std::atomic<bool>*
+  cancel_flag() const
+  {
+    return mCancelFlag;
+  }
+
+  /// @brief 打ち切りフラグが立っている時 true を返す．
+  bool
+  canceled() const
+  {
+    return mCancelFlag != nullptr &&
+      mCancelFlag->load(std::memory_order_relaxed);
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 打ち切りフラグ
+  const std::atomic<bool>* mCancelFlag{nullptr};
+
 };
 
 END_NAMESPACE_YM_MINCOV
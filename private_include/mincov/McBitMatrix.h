@@ -0,0 +1,167 @@
+#ifndef YM_MCBITMATRIX_H
+#define YM_MCBITMATRIX_H
+
+/// @file mincov/McBitMatrix.h
+/// @brief McBitMatrix のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "mincov/mincov_nsdef.h"
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+/// @class McBitMatrix McBitMatrix.h "mincov/McBitMatrix.h"
+/// @brief McMatrix の行(もしくは列)ごとの要素をビットベクタで表したもの
+///
+/// * 行(列)ごとに width ビットのビットベクタを持つ．
+/// * 包含関係のチェックをワード単位の AND-NOT で行える．
+///   AVX2 が使える場合には 4 ワードずつまとめて行う．
+/// * init() を呼ぶ前は無効な状態で，set()/reset() はなにもしない．
+//////////////////////////////////////////////////////////////////////
+class McBitMatrix
+{
+public:
+
+  /// @brief ワードの型
+  using WordType = std::uint64_t;
+
+  /// @brief コンストラクタ
+  ///
+  /// 無効な状態で初期化される．
+  McBitMatrix() = default;
+
+  /// @brief デストラクタ
+  ~McBitMatrix() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 初期化する．
+  ///
+  /// 全てのビットは 0 になる．
+  void
+  init(
+    SizeType size, ///< [in] 行(列)数
+    SizeType width ///< [in] 1行(列)あたりのビット数
+  )
+  {
+    mWordNum = (width + 63) / 64;
+    mBits.clear();
+    mBits.resize(size * mWordNum, 0);
+  }
+
+  /// @brief 無効化する．
+  void
+  clear()
+  {
+    mWordNum = 0;
+    mBits.clear();
+    mBits.shrink_to_fit();
+  }
+
+  /// @brief 有効な時 true を返す．
+  bool
+  is_valid() const
+  {
+    return mWordNum > 0;
+  }
+
+  /// @brief 1行(列)あたりのワード数を返す．
+  SizeType
+  word_num() const
+  {
+    return mWordNum;
+  }
+
+  /// @brief ビットを調べる．
+  bool
+  test(
+    SizeType pos, ///< [in] 行(列)番号
+    SizeType bit  ///< [in] ビット位置
+  ) const
+  {
+    return static_cast<bool>((mBits[pos * mWordNum + bit / 64] >> (bit % 64)) & 1U);
+  }
+
+  /// @brief ビットをセットする．
+  void
+  set(
+    SizeType pos, ///< [in] 行(列)番号
+    SizeType bit  ///< [in] ビット位置
+  )
+  {
+    if ( is_valid() ) {
+      mBits[pos * mWordNum + bit / 64] |= (WordType{1} << (bit % 64));
+    }
+  }
+
+  /// @brief ビットをクリアする．
+  void
+  reset(
+    SizeType pos, ///< [in] 行(列)番号
+    SizeType bit  ///< [in] ビット位置
+  )
+  {
+    if ( is_valid() ) {
+      mBits[pos * mWordNum + bit / 64] &= ~(WordType{1} << (bit % 64));
+    }
+  }
+
+  /// @brief 包含関係を調べる．
+  /// @return pos1 のビットベクタが pos2 のビットをすべて含んでいたら true を返す．
+  bool
+  contains(
+    SizeType pos1, ///< [in] 行(列)番号1
+    SizeType pos2  ///< [in] 行(列)番号2
+  ) const
+  {
+    auto a = &mBits[pos1 * mWordNum];
+    auto b = &mBits[pos2 * mWordNum];
+    SizeType i = 0;
+#if defined(__AVX2__)
+    for ( ; i + 4 <= mWordNum; i += 4 ) {
+      auto va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+      auto vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+      // (~va & vb) が 0 でなければ包含されていない．
+      if ( !_mm256_testc_si256(va, vb) ) {
+	return false;
+      }
+    }
+#endif
+    for ( ; i < mWordNum; ++ i ) {
+      if ( (b[i] & ~a[i]) != 0 ) {
+	return false;
+      }
+    }
+    return true;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 1行(列)あたりのワード数
+  // 0 の時は無効
+  SizeType mWordNum{0};
+
+  // ビットベクタの本体
+  // サイズは行(列)数 x mWordNum
+  vector<WordType> mBits;
+
+};
+
+END_NAMESPACE_YM_MINCOV
+
+#endif // YM_MCBITMATRIX_H
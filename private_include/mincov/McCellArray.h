@@ -0,0 +1,195 @@
+#ifndef YM_MCCELLARRAY_H
+#define YM_MCCELLARRAY_H
+
+/// @file mincov/McCellArray.h
+/// @brief McCellArray のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "mincov/mincov_nsdef.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+/// @class McCellArray McCellArray.h "mincov/McCellArray.h"
+/// @brief McMatrix のコンパクトモード用の要素の配列
+///
+/// * McCell と同じ情報を 32 ビットのインデックスで表す．
+/// * 行番号，列番号，上下左右のリンクをそれぞれ別の配列に持つ
+///   (structure of arrays)．
+/// * 1要素あたり 24 バイトで済む．
+/// * 要素はインデックスで区別する．
+///   McMatrix では行 r のダミー要素を r に，列 c のダミー要素を
+///   row_size + c に置き，その後ろに実際の要素を置く．
+//////////////////////////////////////////////////////////////////////
+class McCellArray
+{
+  friend class McMatrix;
+
+public:
+
+  /// @brief インデックスの型
+  using IndexType = std::uint32_t;
+
+public:
+
+  /// @brief コンストラクタ
+  McCellArray() = default;
+
+  /// @brief デストラクタ
+  ~McCellArray() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 要素数を返す．
+  SizeType
+  size() const
+  {
+    return mRowPosArray.size();
+  }
+
+  /// @brief 行番号を返す．
+  SizeType
+  row_pos(
+    IndexType id ///< [in] 要素のインデックス
+  ) const
+  {
+    return mRowPosArray[id];
+  }
+
+  /// @brief 列番号を返す．
+  SizeType
+  col_pos(
+    IndexType id ///< [in] 要素のインデックス
+  ) const
+  {
+    return mColPosArray[id];
+  }
+
+  /// @brief 同じ行の直前の要素を返す．
+  IndexType
+  row_prev(
+    IndexType id ///< [in] 要素のインデックス
+  ) const
+  {
+    return mLeftArray[id];
+  }
+
+  /// @brief 同じ行の直後の要素を返す．
+  IndexType
+  row_next(
+    IndexType id ///< [in] 要素のインデックス
+  ) const
+  {
+    return mRightArray[id];
+  }
+
+  /// @brief 同じ列の直前の要素を返す．
+  IndexType
+  col_prev(
+    IndexType id ///< [in] 要素のインデックス
+  ) const
+  {
+    return mUpArray[id];
+  }
+
+  /// @brief 同じ列の直後の要素を返す．
+  IndexType
+  col_next(
+    IndexType id ///< [in] 要素のインデックス
+  ) const
+  {
+    return mDownArray[id];
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // McMatrix から用いられる関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 領域を予約する．
+  void
+  reserve(
+    SizeType size ///< [in] 要素数
+  )
+  {
+    mRowPosArray.reserve(size);
+    mColPosArray.reserve(size);
+    mLeftArray.reserve(size);
+    mRightArray.reserve(size);
+    mUpArray.reserve(size);
+    mDownArray.reserve(size);
+  }
+
+  /// @brief 内容をクリアする．
+  void
+  clear()
+  {
+    mRowPosArray.clear();
+    mColPosArray.clear();
+    mLeftArray.clear();
+    mRightArray.clear();
+    mUpArray.clear();
+    mDownArray.clear();
+  }
+
+  /// @brief 要素を追加する．
+  /// @return 追加した要素のインデックスを返す．
+  ///
+  /// リンクは自分自身を指すように初期化される．
+  IndexType
+  new_cell(
+    SizeType row_pos, ///< [in] 行番号
+    SizeType col_pos  ///< [in] 列番号
+  )
+  {
+    if ( size() >= static_cast<SizeType>(UINT32_MAX) ) {
+      throw std::overflow_error{"McCellArray: too many elements"};
+    }
+    auto id = static_cast<IndexType>(size());
+    mRowPosArray.push_back(static_cast<IndexType>(row_pos));
+    mColPosArray.push_back(static_cast<IndexType>(col_pos));
+    mLeftArray.push_back(id);
+    mRightArray.push_back(id);
+    mUpArray.push_back(id);
+    mDownArray.push_back(id);
+    return id;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 行番号の配列
+  vector<IndexType> mRowPosArray;
+
+  // 列番号の配列
+  vector<IndexType> mColPosArray;
+
+  // 左隣の要素の配列
+  vector<IndexType> mLeftArray;
+
+  // 右隣の要素の配列
+  vector<IndexType> mRightArray;
+
+  // 上の要素の配列
+  vector<IndexType> mUpArray;
+
+  // 下の要素の配列
+  vector<IndexType> mDownArray;
+
+};
+
+END_NAMESPACE_YM_MINCOV
+
+#endif // YM_MCCELLARRAY_H
@@ -0,0 +1,108 @@
+#ifndef YM_MCCOMPACTCOLITERATOR_H
+#define YM_MCCOMPACTCOLITERATOR_H
+
+/// @file mincov/McCompactColIterator.h
+/// @brief McCompactColIterator のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "mincov/mincov_nsdef.h"
+#include "mincov/McCellArray.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+/// @class McCompactColIterator McCompactColIterator.h "mincov/McCompactColIterator.h"
+/// @brief コンパクトモードの McMatrix の要素を列方向にたどる反復子
+///
+/// 通常モードの McColIterator と同じ使い方ができる．
+//////////////////////////////////////////////////////////////////////
+class McCompactColIterator
+{
+public:
+
+  /// @brief コンストラクタ
+  McCompactColIterator(
+    const McCellArray* cell_array = nullptr, ///< [in] 要素の配列
+    McCellArray::IndexType id = 0            ///< [in] 対象の要素のインデックス
+  ) : mCellArray{cell_array},
+      mCurId{id}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~McCompactColIterator() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief dereference 演算子
+  /// @return 要素の行番号を返す．
+  SizeType
+  operator*() const
+  {
+    return mCellArray->row_pos(mCurId);
+  }
+
+  /// @brief インクリメント演算子
+  McCompactColIterator
+  operator++()
+  {
+    mCurId = mCellArray->col_next(mCurId);
+    return *this;
+  }
+
+  /// @brief インクリメント演算子(後置)
+  McCompactColIterator
+  operator++(int) // 引数はダミー
+  {
+    auto ans = *this;
+    mCurId = mCellArray->col_next(mCurId);
+    return ans;
+  }
+
+  /// @brief 等価比較演算子
+  ///
+  /// 同じ配列上の反復子どうしを比較するものとする．
+  bool
+  operator==(
+    const McCompactColIterator& right
+  ) const
+  {
+    return mCurId == right.mCurId;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 要素の配列
+  const McCellArray* mCellArray;
+
+  // 現在の要素のインデックス
+  McCellArray::IndexType mCurId;
+
+};
+
+/// @brief 非等価比較演算子
+inline
+bool
+operator!=(
+  const McCompactColIterator& left, ///< [in] オペランド1
+  const McCompactColIterator& right ///< [in] オペランド2
+)
+{
+  return !left.operator==(right);
+}
+
+END_NAMESPACE_YM_MINCOV
+
+#endif // YM_MCCOMPACTCOLITERATOR_H
@@ -0,0 +1,115 @@
+#ifndef YM_MCCOMPACTCOLLIST_H
+#define YM_MCCOMPACTCOLLIST_H
+
+/// @file mincov/McCompactColList.h
+/// @brief McCompactColList のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "mincov/mincov_nsdef.h"
+#include "mincov/McCompactColIterator.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+/// @class McCompactColList McCompactColList.h "mincov/McCompactColList.h"
+/// @brief コンパクトモードの McMatrix の要素を列方向にたどるためのクラス
+///
+/// 通常モードの McColList と同じ使い方ができる．
+/// このクラスは読み出し専用でリストの内容を変えることはできない．
+//////////////////////////////////////////////////////////////////////
+class McCompactColList
+{
+public:
+
+  using iterator = McCompactColIterator;
+
+public:
+
+  /// @brief コンストラクタ
+  McCompactColList(
+    const McCellArray* cell_array,   ///< [in] 要素の配列
+    McCellArray::IndexType begin_id, ///< [in] 先頭の要素
+    McCellArray::IndexType end_id    ///< [in] 末尾の要素
+  ) : mCellArray{cell_array},
+      mBegin{begin_id},
+      mEnd{end_id}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~McCompactColList() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 先頭の反復子を返す．
+  iterator
+  begin() const
+  {
+    return McCompactColIterator{mCellArray, mBegin};
+  }
+
+  /// @brief 末尾の反復子を返す．
+  iterator
+  end() const
+  {
+    return McCompactColIterator{mCellArray, mEnd};
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 要素の配列
+  const McCellArray* mCellArray;
+
+  // 先頭の要素
+  McCellArray::IndexType mBegin;
+
+  // 末尾の要素
+  McCellArray::IndexType mEnd;
+
+};
+
+/// @relates McCompactColList
+/// @brief 等価比較演算子
+bool
+operator==(
+  const McCompactColList& list1,  ///< [in] オペランド1
+  const McCompactColList& list2   ///< [in] オペランド2
+);
+
+/// @relates McCompactColList
+/// @brief 非等価比較演算子
+inline
+bool
+operator!=(
+  const McCompactColList& list1, ///< [in] オペランド1
+  const McCompactColList& list2  ///< [in] オペランド2
+)
+{
+  return !operator==(list1, list2);
+}
+
+/// @relates McCompactColList
+/// @brief 包含関係を調べる．
+///
+/// list1 が list2 の要素をすべて含んでいたら true を返す．
+bool
+check_containment(
+  const McCompactColList& list1,  ///< [in] オペランド1
+  const McCompactColList& list2   ///< [in] オペランド2
+);
+
+END_NAMESPACE_YM_MINCOV
+
+#endif // YM_MCCOMPACTCOLLIST_H
@@ -0,0 +1,108 @@
+#ifndef YM_MCCOMPACTROWITERATOR_H
+#define YM_MCCOMPACTROWITERATOR_H
+
+/// @file mincov/McCompactRowIterator.h
+/// @brief McCompactRowIterator のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "mincov/mincov_nsdef.h"
+#include "mincov/McCellArray.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+/// @class McCompactRowIterator McCompactRowIterator.h "mincov/McCompactRowIterator.h"
+/// @brief コンパクトモードの McMatrix の要素を行方向にたどる反復子
+///
+/// 通常モードの McRowIterator と同じ使い方ができる．
+//////////////////////////////////////////////////////////////////////
+class McCompactRowIterator
+{
+public:
+
+  /// @brief コンストラクタ
+  McCompactRowIterator(
+    const McCellArray* cell_array = nullptr, ///< [in] 要素の配列
+    McCellArray::IndexType id = 0            ///< [in] 対象の要素のインデックス
+  ) : mCellArray{cell_array},
+      mCurId{id}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~McCompactRowIterator() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief dereference 演算子
+  /// @return 要素の列番号を返す．
+  SizeType
+  operator*() const
+  {
+    return mCellArray->col_pos(mCurId);
+  }
+
+  /// @brief インクリメント演算子
+  McCompactRowIterator
+  operator++()
+  {
+    mCurId = mCellArray->row_next(mCurId);
+    return *this;
+  }
+
+  /// @brief インクリメント演算子(後置)
+  McCompactRowIterator
+  operator++(int) // 引数はダミー
+  {
+    auto ans = *this;
+    mCurId = mCellArray->row_next(mCurId);
+    return ans;
+  }
+
+  /// @brief 等価比較演算子
+  ///
+  /// 同じ配列上の反復子どうしを比較するものとする．
+  bool
+  operator==(
+    const McCompactRowIterator& right
+  ) const
+  {
+    return mCurId == right.mCurId;
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 要素の配列
+  const McCellArray* mCellArray;
+
+  // 現在の要素のインデックス
+  McCellArray::IndexType mCurId;
+
+};
+
+/// @brief 非等価比較演算子
+inline
+bool
+operator!=(
+  const McCompactRowIterator& left, ///< [in] オペランド1
+  const McCompactRowIterator& right ///< [in] オペランド2
+)
+{
+  return !left.operator==(right);
+}
+
+END_NAMESPACE_YM_MINCOV
+
+#endif // YM_MCCOMPACTROWITERATOR_H
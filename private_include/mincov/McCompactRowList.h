@@ -0,0 +1,122 @@
+#ifndef YM_MCCOMPACTROWLIST_H
+#define YM_MCCOMPACTROWLIST_H
+
+/// @file mincov/McCompactRowList.h
+/// @brief McCompactRowList のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "mincov/mincov_nsdef.h"
+#include "mincov/McCompactRowIterator.h"
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+/// @class McCompactRowList McCompactRowList.h "mincov/McCompactRowList.h"
+/// @brief コンパクトモードの McMatrix の要素を行方向にたどるためのクラス
+///
+/// 通常モードの McRowList と同じ使い方ができる．
+/// このクラスは読み出し専用でリストの内容を変えることはできない．
+//////////////////////////////////////////////////////////////////////
+class McCompactRowList
+{
+public:
+
+  using iterator = McCompactRowIterator;
+
+public:
+
+  /// @brief コンストラクタ
+  McCompactRowList(
+    const McCellArray* cell_array,   ///< [in] 要素の配列
+    McCellArray::IndexType begin_id, ///< [in] 先頭の要素
+    McCellArray::IndexType end_id    ///< [in] 末尾の要素
+  ) : mCellArray{cell_array},
+      mBegin{begin_id},
+      mEnd{end_id}
+  {
+  }
+
+  /// @brief デストラクタ
+  ~McCompactRowList() = default;
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 先頭の要素の列番号を返す．
+  SizeType
+  front() const
+  {
+    return mCellArray->col_pos(mBegin);
+  }
+
+  /// @brief 先頭の反復子を返す．
+  iterator
+  begin() const
+  {
+    return McCompactRowIterator{mCellArray, mBegin};
+  }
+
+  /// @brief 末尾の反復子を返す．
+  iterator
+  end() const
+  {
+    return McCompactRowIterator{mCellArray, mEnd};
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 要素の配列
+  const McCellArray* mCellArray;
+
+  // 先頭の要素
+  McCellArray::IndexType mBegin;
+
+  // 末尾の要素
+  McCellArray::IndexType mEnd;
+
+};
+
+/// @relates McCompactRowList
+/// @brief 等価比較演算子
+bool
+operator==(
+  const McCompactRowList& list1,  ///< [in] オペランド1
+  const McCompactRowList& list2   ///< [in] オペランド2
+);
+
+/// @relates McCompactRowList
+/// @brief 非等価比較演算子
+inline
+bool
+operator!=(
+  const McCompactRowList& list1, ///< [in] オペランド1
+  const McCompactRowList& list2  ///< [in] オペランド2
+)
+{
+  return !operator==(list1, list2);
+}
+
+/// @relates McCompactRowList
+/// @brief 包含関係を調べる．
+///
+/// list1 が list2 の要素をすべて含んでいたら true を返す．
+bool
+check_containment(
+  const McCompactRowList& list1,  ///< [in] オペランド1
+  const McCompactRowList& list2   ///< [in] オペランド2
+);
+
+END_NAMESPACE_YM_MINCOV
+
+#endif // YM_MCCOMPACTROWLIST_H
@@ -20,6 +20,7 @@ BEGIN_NAMESPACE_YM_MINCOV
 /// * 行か列かを表す1ビットのフラグ
 /// * 行番号/列番号
 /// * 削除フラグ
+/// * dirty フラグと grown フラグ
 /// * 行/列の要素数
 //////////////////////////////////////////////////////////////////////
 class McHead
@@ -81,22 +82,23 @@ public:
   SizeType
   num() const
   {
-    return mNum >> 2;
+    return mNum >> 3;
   }
 
   /// @brief 要素数を増やす．
   void
   inc_num()
   {
-    mNum += 4;
+    mNum += 8;
     set_dirty(true);
+    set_grown(true);
   }
 
   /// @brief 要素数を減らす．
   void
   dec_num()
   {
-    mNum -= 4;
+    mNum -= 8;
     set_dirty(true);
   }
 
@@ -142,6 +144,29 @@ public:
     }
   }
 
+  /// @brief grown フラグを返す．
+  ///
+  /// 前回フラグを降ろしてから要素数の増えたことがある時に true となる．
+  bool
+  is_grown() const
+  {
+    return static_cast<bool>((mNum >> 2) & 1U);
+  }
+
+  /// @brief grown フラグをセットする．
+  void
+  set_grown(
+    bool flag ///< [in] フラグの値
+  )
+  {
+    if ( flag ) {
+      mNum |= 4U;
+    }
+    else {
+      mNum &= ~4U;
+    }
+  }
+
   /// @brief 直前のヘッダを返す．
   const McHead*
   prev() const
@@ -166,7 +191,7 @@ private:
   // 最下位ビットが 0:行, 1:列 を表す．
   SizeType mPos;
 
-  // 要素数 + dirty フラグ + 削除フラグ
+  // 要素数 + grown フラグ + dirty フラグ + 削除フラグ
   SizeType mNum;
 
   // 直前のヘッダを指すリンク
@@ -12,9 +12,14 @@
 #include "mincov/mincov_nsdef.h"
 #include "mincov/McHead.h"
 #include "mincov/McHeadList.h"
+#include "mincov/McCellArray.h"
+#include "mincov/McBitMatrix.h"
 #include "mincov/McRowList.h"
 #include "mincov/McColList.h"
+#include "mincov/McCompactRowList.h"
+#include "mincov/McCompactColList.h"
 #include "mincov/McColComp.h"
+#include "mincov/McObserver.h"
 
 
 BEGIN_NAMESPACE_YM_MINCOV
@@ -27,11 +32,115 @@ BEGIN_NAMESPACE_YM_MINCOV
 /// * 1 の要素のみを持つので，1の要素が相対的に少ないスパースの時に効率がよい．
 /// * 要素は行方向・列方向にそれぞれ双方向リストでつながっている．
 /// * さらに，現在アクティブな行，列のヘッダがそれぞれ双方向リストでつながっている．
+/// * 要素の持ち方には2通りある．
+///   - 通常モード: 要素ごとに McCell を確保し，ポインタでつなぐ．
+///   - コンパクトモード: McCellArray 上に 32 ビットのインデックスでつなぐ．
+///     メモリ使用量は通常モードの半分以下になる．
+///   要素をたどる反復子はモードごとに別の型になる
+///   (通常モードは McRowList/McColList，コンパクトモードは
+///   McCompactRowList/McCompactColList)．
+///   両方のモードで動く処理は with_lists() にジェネリックラムダを渡して書く．
+///   モードの判定は with_lists() の呼び出しごとに1度だけ行われ，
+///   要素ごとの処理にはモードの分岐が入らない．
+/// * 支配関係のチェック用に行/列ごとに 64 ビットのシグネチャを持つ．
+///   さらに行列が大きすぎなければ行/列ごとのビットベクタも持つ．
+/// * McObserver を登録すると行と列の削除/復元が通知される．
+///   登録されていない時は通知のための処理はほとんど行わない．
 //////////////////////////////////////////////////////////////////////
 class McMatrix
 {
   using ElemType = MinCov::ElemType;
 
+public:
+
+  /// @brief 通常モードの行/列のリストを取り出すクラス
+  class CellLists
+  {
+  public:
+
+    /// @brief コンストラクタ
+    CellLists(
+      McCell* const* row_array, ///< [in] 行のダミーセルの配列
+      McCell* const* col_array  ///< [in] 列のダミーセルの配列
+    ) : mRowArray{row_array},
+	mColArray{col_array}
+    {
+    }
+
+    /// @brief 行方向のリストを返す．
+    McRowList
+    row_list(
+      SizeType row_pos ///< [in] 行番号
+    ) const
+    {
+      auto dummy = mRowArray[row_pos];
+      return McRowList(dummy->row_next(), dummy);
+    }
+
+    /// @brief 列方向のリストを返す．
+    McColList
+    col_list(
+      SizeType col_pos ///< [in] 列番号
+    ) const
+    {
+      auto dummy = mColArray[col_pos];
+      return McColList(dummy->col_next(), dummy);
+    }
+
+  private:
+
+    // 行のダミーセルの配列
+    McCell* const* mRowArray;
+
+    // 列のダミーセルの配列
+    McCell* const* mColArray;
+
+  };
+
+  /// @brief コンパクトモードの行/列のリストを取り出すクラス
+  class CompactLists
+  {
+  public:
+
+    /// @brief コンストラクタ
+    CompactLists(
+      const McCellArray* cell_array, ///< [in] 要素の配列
+      SizeType row_size              ///< [in] 行数
+    ) : mCellArray{cell_array},
+	mRowSize{row_size}
+    {
+    }
+
+    /// @brief 行方向のリストを返す．
+    McCompactRowList
+    row_list(
+      SizeType row_pos ///< [in] 行番号
+    ) const
+    {
+      auto dummy = static_cast<McCellArray::IndexType>(row_pos);
+      return McCompactRowList(mCellArray, mCellArray->row_next(dummy), dummy);
+    }
+
+    /// @brief 列方向のリストを返す．
+    McCompactColList
+    col_list(
+      SizeType col_pos ///< [in] 列番号
+    ) const
+    {
+      auto dummy = static_cast<McCellArray::IndexType>(mRowSize + col_pos);
+      return McCompactColList(mCellArray, mCellArray->col_next(dummy), dummy);
+    }
+
+  private:
+
+    // 要素の配列
+    const McCellArray* mCellArray;
+
+    // 行数
+    SizeType mRowSize;
+
+  };
+
 public:
 
   /// @brief コンストラクタ
@@ -39,44 +148,38 @@ public:
     SizeType row_size,                ///< [in] 行数
     SizeType col_size,		      ///< [in] 列数
     const vector<ElemType>& elem_list ///< [in] 要素のリスト
-    = vector<ElemType>{}
-  ) : McMatrix{row_size, vector<SizeType>(col_size, 1), elem_list}
+    = vector<ElemType>{},
+    bool compact = false              ///< [in] コンパクトモードの時 true にする．
+  ) : McMatrix{row_size, vector<SizeType>(col_size, 1), elem_list, compact}
   {
   }
 
   /// @brief コンストラクタ
   ///
-  /// 列数は cost_array.size() から得る．
+  /// * 列数は cost_array.size() から得る．
+  /// * elem_list の順番は任意でよい．重複した要素は無視される．
   McMatrix(
     SizeType row_size,                  ///< [in] 行数
     const vector<SizeType>& cost_array, ///< [in] コストの配列
     const vector<ElemType>& elem_list   ///< [in] 要素のリスト
-    = vector<ElemType>{}
+    = vector<ElemType>{},
+    bool compact = false                ///< [in] コンパクトモードの時 true にする．
   );
 
-#if 0
-  /// @brief コピーコンストラクタ
+  /// @brief コピーコンストラクタ(禁止)
+  ///
+  /// 行と列のリストは mCellSlabList 上のセルを指しているので
+  /// メンバごとのコピーでは正しい行列にならない．
+  /// 行列を複製する時は McBlock::new_matrix() を用いる．
   McMatrix(
     const McMatrix& src ///< [in] コピー元のオブジェクト
-  );
+  ) = delete;
 
-  /// @brief コピー代入演算子
+  /// @brief コピー代入演算子(禁止)
   McMatrix&
   operator=(
     const McMatrix& src ///< [in] コピー元のオブジェクト
-  );
-
-  /// @brief ムーブコンストラクタ
-  McMatrix(
-    McMatrix&& src ///< [in] ムーブ元のオブジェクト
-  );
-
-  /// @brief ムーブ代入演算子
-  McMatrix&
-  operator=(
-    McMatrix&& src ///< [in] ムーブ元のオブジェクト
-  );
-#endif
+  ) = delete;
 
   /// @brief デストラクタ
   ~McMatrix();
@@ -87,6 +190,13 @@ public:
   // 情報を取り出す関数
   //////////////////////////////////////////////////////////////////////
 
+  /// @brief コンパクトモードの時 true を返す．
+  bool
+  is_compact() const
+  {
+    return mCompact;
+  }
+
   /// @brief 行数を返す．
   SizeType
   row_size() const
@@ -109,13 +219,26 @@ public:
   }
 
   /// @brief 行方向のリストを返す．
+  ///
+  /// 通常モードでのみ用いることができる．
+  /// 両方のモードで用いる時は with_lists() を用いる．
   McRowList
   row_list(
     SizeType row_pos ///< [in] 行番号 ( 0 <= row_pos < row_size() )
   ) const
   {
-    auto dummy = mRowArray[row_pos];
-    return McRowList(dummy->row_next(), dummy);
+    ASSERT_COND( !mCompact );
+    return cell_lists().row_list(row_pos);
+  }
+
+  /// @brief コンパクトモードで行方向のリストを返す．
+  McCompactRowList
+  compact_row_list(
+    SizeType row_pos ///< [in] 行番号 ( 0 <= row_pos < row_size() )
+  ) const
+  {
+    ASSERT_COND( mCompact );
+    return compact_lists().row_list(row_pos);
   }
 
   /// @brief 行の要素数を返す．
@@ -158,13 +281,81 @@ public:
   }
 
   /// @brief 列方向のリストを返す．
+  ///
+  /// 通常モードでのみ用いることができる．
+  /// 両方のモードで用いる時は with_lists() を用いる．
   McColList
   col_list(
     SizeType col_pos ///< [in] 列位置 ( 0 <= col_pos < col_size() )
   ) const
   {
-    auto dummy = mColArray[col_pos];
-    return McColList(dummy->col_next(), dummy);
+    ASSERT_COND( !mCompact );
+    return cell_lists().col_list(col_pos);
+  }
+
+  /// @brief コンパクトモードで列方向のリストを返す．
+  McCompactColList
+  compact_col_list(
+    SizeType col_pos ///< [in] 列位置 ( 0 <= col_pos < col_size() )
+  ) const
+  {
+    ASSERT_COND( mCompact );
+    return compact_lists().col_list(col_pos);
+  }
+
+  /// @brief モードに応じた行/列のリストの取り出し方で func を呼ぶ．
+  /// @return func の返り値を返す．
+  ///
+  /// func は CellLists か CompactLists の const 参照を引数にとる．
+  /// どちらも row_list(row_pos)/col_list(col_pos) を持つので
+  /// ジェネリックラムダを渡せばモードごとに特殊化されたコードになる．
+  /// 行列の要素を追加したり大きさを変えたら取り出したものは使えない．
+  template<class Func>
+  decltype(auto)
+  with_lists(
+    Func&& func ///< [in] 処理を行う関数
+  ) const
+  {
+    if ( mCompact ) {
+      return func(compact_lists());
+    }
+    return func(cell_lists());
+  }
+
+  /// @brief 行の要素の列番号をベクタにして返す．
+  ///
+  /// モードによらずに行の内容を比較するための関数
+  vector<SizeType>
+  row_elems(
+    SizeType row_pos ///< [in] 行番号 ( 0 <= row_pos < row_size() )
+  ) const
+  {
+    return with_lists([&](const auto& lists) {
+      vector<SizeType> ans;
+      ans.reserve(row_elem_num(row_pos));
+      for ( auto col_pos: lists.row_list(row_pos) ) {
+	ans.push_back(col_pos);
+      }
+      return ans;
+    });
+  }
+
+  /// @brief 列の要素の行番号をベクタにして返す．
+  ///
+  /// モードによらずに列の内容を比較するための関数
+  vector<SizeType>
+  col_elems(
+    SizeType col_pos ///< [in] 列位置 ( 0 <= col_pos < col_size() )
+  ) const
+  {
+    return with_lists([&](const auto& lists) {
+      vector<SizeType> ans;
+      ans.reserve(col_elem_num(col_pos));
+      for ( auto row_pos: lists.col_list(col_pos) ) {
+	ans.push_back(row_pos);
+      }
+      return ans;
+    });
   }
 
   /// @brief 列の要素数を返す．
@@ -201,6 +392,45 @@ public:
     return mCostArray;
   }
 
+  /// @brief アクティブな行と列の集合のハッシュ値を返す．
+  ///
+  /// 行と列ごとに決まった乱数(Zobrist キー)を割り当て，
+  /// アクティブな行と列のキーの排他的論理和をとったもの．
+  /// 行と列の削除/復元のたびに差分で更新される．
+  /// 要素は行と列の削除でしか消えないので，同じ行列の中では
+  /// アクティブな行と列の集合が等しければ内容も等しい．
+  std::uint64_t
+  hash() const
+  {
+    return mHash;
+  }
+
+  /// @brief 行の包含関係を調べる．
+  /// @return 行 row_pos1 が行 row_pos2 の要素をすべて含んでいたら true を返す．
+  ///
+  /// シグネチャで大半の候補を除外してから，
+  /// ビットベクタ(なければリスト)で調べる．
+  bool
+  row_contains(
+    SizeType row_pos1, ///< [in] 行番号1
+    SizeType row_pos2  ///< [in] 行番号2
+  ) const;
+
+  /// @brief 列の包含関係を調べる．
+  /// @return 列 col_pos1 が列 col_pos2 の要素をすべて含んでいたら true を返す．
+  bool
+  col_contains(
+    SizeType col_pos1, ///< [in] 列番号1
+    SizeType col_pos2  ///< [in] 列番号2
+  ) const;
+
+  /// @brief 包含関係のチェックにビットベクタを用いている時 true を返す．
+  bool
+  use_bits() const
+  {
+    return mRowBits.is_valid();
+  }
+
   /// @brief 列集合のコストを返す．
   SizeType
   cost(
@@ -257,6 +487,8 @@ public:
   ///
   /// * この関数は行支配，列支配，必須列を１回だけ適用する．
   /// * この関数が false を返すまで繰り返す必要がある．
+  /// * 調べるのは前回の縮約以降に要素数の変化した行/列
+  ///   (dirty フラグの立っている行/列)の近傍のみである．
   /// * selected_cols, deleted_cols はこの関数内で初期化されず，
   ///   追加されるだけなので注意．
   bool
@@ -289,21 +521,25 @@ public:
   );
 
   /// @brief 行に dirty フラグをつける．
+  ///
+  /// dirty な行は次の reduce() で支配関係のチェックの対象となる．
   void
   set_row_dirty(
     SizeType row_pos ///< [in] 行番号
   )
   {
-    mRowHeadArray[row_pos].set_dirty(false);
+    add_row_work(row_pos);
   }
 
   /// @brief 列に dirty フラグをつける．
+  ///
+  /// dirty な列は次の reduce() で支配関係のチェックの対象となる．
   void
   set_col_dirty(
     SizeType col_pos ///< [in] 列番号
   )
   {
-    mColHeadArray[col_pos].set_dirty(true);
+    add_col_work(col_pos);
   }
 
   /// @brief 削除スタックにマーカーを書き込む．
@@ -315,6 +551,35 @@ public:
   restore();
 
 
+public:
+  //////////////////////////////////////////////////////////////////////
+  // McObserver の登録を行う関数
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief McObserver を登録する．
+  ///
+  /// 通常は McObserver::attach() を用いる．
+  /// 登録は行列の内容を変えないので const 関数としている．
+  void
+  add_observer(
+    McObserver* observer ///< [in] 登録するオブジェクト
+  ) const
+  {
+    mObserverList.add(this, observer);
+  }
+
+  /// @brief McObserver の登録を解除する．
+  ///
+  /// 通常は McObserver::detach() を用いる．
+  void
+  remove_observer(
+    McObserver* observer ///< [in] 解除するオブジェクト
+  ) const
+  {
+    mObserverList.remove(observer);
+  }
+
+
 private:
   //////////////////////////////////////////////////////////////////////
   // 内部で用いられる関数
@@ -329,6 +594,16 @@ private:
     SizeType col_size  ///< [in] 列数
   );
 
+  /// @brief 空の行列に要素のリストをまとめて設定する．
+  ///
+  /// * 行番号と列番号で計数ソートしてから一回の走査でリンクを張るので
+  ///   要素数に対して線形時間で済む．
+  /// * 重複した要素は取り除かれる．
+  void
+  build(
+    const vector<ElemType>& elem_list ///< [in] 要素のリスト
+  );
+
   /// @brief 内容をコピーする．
   void
   copy(
@@ -341,6 +616,15 @@ private:
   bool
   row_dominance();
 
+  /// @brief row_dominance() の本体
+  ///
+  /// Lists は CellLists か CompactLists
+  template<class Lists>
+  bool
+  row_dominance(
+    const Lists& lists ///< [in] 行/列のリストの取り出し方
+  );
+
   /// @brief 列支配による縮約を行う．
   /// @retval true 縮約が行われた．
   /// @retval false 縮約が行われなかった．
@@ -350,6 +634,35 @@ private:
     const McColComp& col_comp	    ///< [in]  列の比較関数オブジェクト
   );
 
+  /// @brief col_dominance() の本体
+  ///
+  /// Lists は CellLists か CompactLists
+  template<class Lists>
+  bool
+  col_dominance(
+    const Lists& lists,             ///< [in] 行/列のリストの取り出し方
+    vector<SizeType>& deleted_cols, ///< [out] この縮約で削除された列を格納するベクタ
+    const McColComp& col_comp	    ///< [in]  列の比較関数オブジェクト
+  );
+
+  /// @brief row_contains() の本体
+  template<class Lists>
+  bool
+  row_contains(
+    const Lists& lists, ///< [in] 行/列のリストの取り出し方
+    SizeType row_pos1,  ///< [in] 行番号1
+    SizeType row_pos2   ///< [in] 行番号2
+  ) const;
+
+  /// @brief col_contains() の本体
+  template<class Lists>
+  bool
+  col_contains(
+    const Lists& lists, ///< [in] 行/列のリストの取り出し方
+    SizeType col_pos1,  ///< [in] 列番号1
+    SizeType col_pos2   ///< [in] 列番号2
+  ) const;
+
   /// @brief 必須列による縮約を行う．
   /// @retval true 縮約が行われた．
   /// @retval false 縮約が行われなかった．
@@ -358,6 +671,159 @@ private:
     vector<SizeType>& selected_cols ///< [out] この縮約で選択された列を格納するベクタ
   );
 
+  /// @brief 行を作業リストに加える．
+  ///
+  /// すでに dirty フラグが立っている場合にはなにもしない．
+  void
+  add_row_work(
+    SizeType row_pos ///< [in] 行番号
+  )
+  {
+    auto& head = mRowHeadArray[row_pos];
+    if ( !head.is_dirty() ) {
+      head.set_dirty(true);
+      mRowWorkList.push_back(row_pos);
+    }
+  }
+
+  /// @brief 列を作業リストに加える．
+  ///
+  /// すでに dirty フラグが立っている場合にはなにもしない．
+  void
+  add_col_work(
+    SizeType col_pos ///< [in] 列番号
+  )
+  {
+    auto& head = mColHeadArray[col_pos];
+    if ( !head.is_dirty() ) {
+      head.set_dirty(true);
+      mColWorkList.push_back(col_pos);
+    }
+  }
+
+  /// @brief 行の要素数を増やし，作業リストに加える．
+  ///
+  /// シグネチャも無効化する．
+  void
+  inc_row_num(
+    SizeType row_pos ///< [in] 行番号
+  )
+  {
+    add_row_work(row_pos);
+    mRowHeadArray[row_pos].inc_num();
+    mRowSigArray[row_pos] = 0;
+  }
+
+  /// @brief 行の要素数を減らし，作業リストに加える．
+  ///
+  /// シグネチャも無効化する．
+  void
+  dec_row_num(
+    SizeType row_pos ///< [in] 行番号
+  )
+  {
+    add_row_work(row_pos);
+    mRowHeadArray[row_pos].dec_num();
+    mRowSigArray[row_pos] = 0;
+  }
+
+  /// @brief 列の要素数を増やし，作業リストに加える．
+  ///
+  /// シグネチャも無効化する．
+  void
+  inc_col_num(
+    SizeType col_pos ///< [in] 列番号
+  )
+  {
+    add_col_work(col_pos);
+    mColHeadArray[col_pos].inc_num();
+    mColSigArray[col_pos] = 0;
+  }
+
+  /// @brief 列の要素数を減らし，作業リストに加える．
+  ///
+  /// シグネチャも無効化する．
+  void
+  dec_col_num(
+    SizeType col_pos ///< [in] 列番号
+  )
+  {
+    add_col_work(col_pos);
+    mColHeadArray[col_pos].dec_num();
+    mColSigArray[col_pos] = 0;
+  }
+
+  /// @brief 行のシグネチャを返す．
+  ///
+  /// 無効化されていたら計算し直す．
+  template<class Lists>
+  std::uint64_t
+  row_sig(
+    const Lists& lists, ///< [in] 行/列のリストの取り出し方
+    SizeType row_pos    ///< [in] 行番号
+  ) const;
+
+  /// @brief 列のシグネチャを返す．
+  ///
+  /// 無効化されていたら計算し直す．
+  template<class Lists>
+  std::uint64_t
+  col_sig(
+    const Lists& lists, ///< [in] 行/列のリストの取り出し方
+    SizeType col_pos    ///< [in] 列番号
+  ) const;
+
+  /// @brief シグネチャとビットベクタを初期化する．
+  void
+  init_bits();
+
+  /// @brief 行の作業リストをクリアする．
+  ///
+  /// 作業リストに入っていた行の dirty フラグも降ろす．
+  void
+  clear_row_work();
+
+  /// @brief 列の作業リストをクリアする．
+  ///
+  /// 作業リストに入っていた列の dirty フラグも降ろす．
+  void
+  clear_col_work();
+
+  /// @brief 列を選択する(通知は行わない)．
+  void
+  _select_col(
+    SizeType col_pos ///< [in] 選択する列番号
+  );
+
+  /// @brief 行を削除する(通知は行わない)．
+  void
+  _delete_row(
+    SizeType row_pos ///< [in] 削除する行番号
+  );
+
+  /// @brief 列を削除する(通知は行わない)．
+  void
+  _delete_col(
+    SizeType col_pos ///< [in] 削除する列番号
+  );
+
+  /// @brief 溜まっている変更を McObserver に通知する．
+  void
+  flush_event(
+    bool restored ///< [in] 復元の時 true にする．
+  )
+  {
+    if ( !mObserverList.empty() ) {
+      notify_event(restored);
+    }
+  }
+
+  /// @brief 溜まっている変更を McObserver に通知する．
+  void
+  notify_event(
+    bool restored ///< [in] 復元の時 true にする．
+  );
+
   /// @brief 行を復元する．
   void
   restore_row(
@@ -383,7 +849,13 @@ private:
     McHead* head
   )
   {
-    mDelStack[mStackTop] = head;
+    // save() のマーカーの分だけ行数 + 列数を超えることがある．
+    if ( mStackTop < mDelStack.size() ) {
+      mDelStack[mStackTop] = head;
+    }
+    else {
+      mDelStack.push_back(head);
+    }
     ++ mStackTop;
   }
 
@@ -415,25 +887,118 @@ private:
     mColHeadArray[col_pos].set_deleted(flag);
   }
 
+  /// @brief 行の Zobrist キーを返す．
+  static
+  std::uint64_t
+  row_key(
+    SizeType row_pos ///< [in] 行番号
+  )
+  {
+    return zobrist_key(row_pos * 2);
+  }
+
+  /// @brief 列の Zobrist キーを返す．
+  static
+  std::uint64_t
+  col_key(
+    SizeType col_pos ///< [in] 列番号
+  )
+  {
+    return zobrist_key(col_pos * 2 + 1);
+  }
+
+  /// @brief Zobrist キーを作る．
+  ///
+  /// 表を持たずに済むように splitmix64 で番号から直接求める．
+  static
+  std::uint64_t
+  zobrist_key(
+    SizeType id ///< [in] 行/列の通し番号
+  )
+  {
+    std::uint64_t x = static_cast<std::uint64_t>(id) + 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  }
+
   /// @brief mRowMark, mColMark の sanity check
   /// @retval true mRowMark, mColMark の内容が全て 0 だった．
   /// @retval false mRowMark, mColMark に非0の要素が含まれていた．
   bool
   check_mark_sanity();
 
+  /// @brief コンパクトモードで要素を追加する．
+  void
+  insert_elem_compact(
+    SizeType row_pos, ///< [in] 行番号
+    SizeType col_pos  ///< [in] 列番号
+  );
+
+  /// @brief ダミーセルを作る．
+  ///
+  /// elem_num 個の要素を追加する分の領域もあわせて確保する．
+  void
+  init_dummies(
+    SizeType elem_num ///< [in] 追加予定の要素数
+  );
+
   /// @brief セルの生成
+  ///
+  /// セルは mCellSlabList 上に確保される．
   McCell*
   alloc_cell(
     SizeType row_pos, ///< [in] 行番号
     SizeType col_pos  ///< [in] 列番号
   );
 
+  /// @brief セル用の領域(スラブ)を追加する．
+  void
+  new_slab(
+    SizeType size ///< [in] 確保するセル数
+  );
+
+  /// @brief 通常モードの行/列のリストの取り出し方を返す．
+  CellLists
+  cell_lists() const
+  {
+    return CellLists{mRowArray.data(), mColArray.data()};
+  }
+
+  /// @brief コンパクトモードの行/列のリストの取り出し方を返す．
+  CompactLists
+  compact_lists() const
+  {
+    return CompactLists{&mCellArray, mRowSize};
+  }
+
+  /// @brief コンパクトモードで行のダミー要素のインデックスを返す．
+  McCellArray::IndexType
+  row_dummy_id(
+    SizeType row_pos ///< [in] 行番号
+  ) const
+  {
+    return static_cast<McCellArray::IndexType>(row_pos);
+  }
+
+  /// @brief コンパクトモードで列のダミー要素のインデックスを返す．
+  McCellArray::IndexType
+  col_dummy_id(
+    SizeType col_pos ///< [in] 列番号
+  ) const
+  {
+    return static_cast<McCellArray::IndexType>(mRowSize + col_pos);
+  }
+
 
 private:
   //////////////////////////////////////////////////////////////////////
   // データメンバ
   //////////////////////////////////////////////////////////////////////
 
+  // コンパクトモードの時 true にするフラグ
+  bool mCompact{false};
+
   // 行数
   SizeType mRowSize{0};
 
@@ -446,6 +1011,7 @@ private:
 
   // 行の先頭を表すダミーセルの配列
   // サイズは mRowSize
+  // コンパクトモードの時は用いない．
   vector<McCell*> mRowArray;
 
   // 列数
@@ -460,14 +1026,21 @@ private:
 
   // 列の先頭を表すダミーセルの配列
   // サイズは mColSize
+  // コンパクトモードの時は用いない．
   vector<McCell*> mColArray;
 
   // コストの配列
   // サイズは mColSize;
   vector<SizeType> mCostArray;
 
-  // 確保したセルの所有権を持つ．
-  vector<std::unique_ptr<McCell>> mCellList;
+  // セルを確保するための領域(スラブ)のリスト
+  // 個々のスラブは capacity() を超えて伸長させないので
+  // セルのアドレスは変わらない．
+  // セルはスラブ単位でまとめて解放される．
+  vector<vector<McCell>> mCellSlabList;
+
+  // コンパクトモード用の要素の配列
+  McCellArray mCellArray;
 
   // 削除の履歴を覚えておくスタック
   vector<McHead*> mDelStack;
@@ -475,6 +1048,41 @@ private:
   // mDelStack のポインタ
   SizeType mStackTop{0};
 
+  // save() 時点で作業リストが空だったかを覚えておくスタック
+  // 空だった場合にはその時点の行列は縮約済みなので，
+  // restore() 後に作業リストを空に戻せる．
+  vector<bool> mCleanStack;
+
+  // 支配関係をチェックする必要のある行のリスト
+  // dirty フラグの立っている行と一致する．
+  vector<SizeType> mRowWorkList;
+
+  // 支配関係をチェックする必要のある列のリスト
+  // dirty フラグの立っている列と一致する．
+  vector<SizeType> mColWorkList;
+
+  // 行のシグネチャの配列
+  // 行に含まれる列番号をハッシュした 64 ビットのビットベクタ
+  // 0 の時は無効化されている．
+  // サイズは mRowSize
+  mutable
+  vector<std::uint64_t> mRowSigArray;
+
+  // 列のシグネチャの配列
+  // 列に含まれる行番号をハッシュした 64 ビットのビットベクタ
+  // 0 の時は無効化されている．
+  // サイズは mColSize
+  mutable
+  vector<std::uint64_t> mColSigArray;
+
+  // 行ごとの列のビットベクタ
+  // 行列が大きい時は用いない(無効になる)．
+  McBitMatrix mRowBits;
+
+  // 列ごとの行のビットベクタ
+  // 行列が大きい時は用いない(無効になる)．
+  McBitMatrix mColBits;
+
   // 作業用に使う行のマーク配列
   // サイズは mRowSize
   mutable
@@ -490,6 +1098,21 @@ private:
   mutable
   vector<SizeType> mDelList;
 
+  // アクティブな行と列の集合のハッシュ値
+  std::uint64_t mHash{0};
+
+  // 登録されている McObserver のリスト
+  mutable
+  McObserverList mObserverList;
+
+  // まだ通知していない削除/復元された行のリスト
+  // McObserver が登録されている時しか用いない．
+  vector<SizeType> mRowEventList;
+
+  // まだ通知していない削除/復元された列のリスト
+  // McObserver が登録されている時しか用いない．
+  vector<SizeType> mColEventList;
+
 };
 
 END_NAMESPACE_YM_MINCOV
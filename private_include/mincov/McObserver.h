@@ -0,0 +1,238 @@
+#ifndef YM_MCOBSERVER_H
+#define YM_MCOBSERVER_H
+
+/// @file mincov/McObserver.h
+/// @brief McObserver のヘッダファイル
+/// @author Yusuke Matsunaga (松永 裕介)
+///
+/// Copyright (C) 2025 Yusuke Matsunaga
+/// All rights reserved.
+
+#include "mincov/mincov_nsdef.h"
+#include <mutex>
+
+
+BEGIN_NAMESPACE_YM_MINCOV
+
+//////////////////////////////////////////////////////////////////////
+/// @class McObserver McObserver.h "mincov/McObserver.h"
+/// @brief McMatrix の行と列の削除/復元の通知を受け取るクラス
+///
+/// 行列に登録しておくと行と列の削除/復元が起きるたびに
+/// 変更された行番号/列番号のリストが通知される．
+/// 行や列ごとの情報を差分で更新したいクラスはこれを継承する．
+///
+/// * 通知は McMatrix の公開関数(delete_row(), delete_col(),
+///   select_col(), reduce(), restore())ごとにまとめて行われる．
+///   通知の時点の行列はその関数の変更をすべて反映している．
+/// * 1回の通知では削除だけか復元だけが起こる．
+/// * 観測している行列が破棄されたり，要素の追加や代入で内容が変わった時には
+///   自動的に登録が外れ，observed_matrix() が nullptr となる．
+/// * 登録と登録の解除はスレッドセーフだが，
+///   通知自体は行列を変更したスレッドで行われる．
+//////////////////////////////////////////////////////////////////////
+class McObserver
+{
+  friend class McObserverList;
+
+public:
+
+  /// @brief コンストラクタ
+  McObserver() = default;
+
+  /// @brief コピーコンストラクタ
+  ///
+  /// 登録はコピーしない．
+  McObserver(
+    const McObserver& src ///< [in] コピー元のオブジェクト
+  )
+  {
+  }
+
+  /// @brief コピー代入演算子
+  ///
+  /// 登録はコピーしない．
+  McObserver&
+  operator=(
+    const McObserver& src ///< [in] コピー元のオブジェクト
+  )
+  {
+    return *this;
+  }
+
+  /// @brief デストラクタ
+  ///
+  /// 登録されていたら解除する．
+  virtual
+  ~McObserver();
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 行列に登録する．
+  ///
+  /// 他の行列に登録されていたらそちらの登録は解除される．
+  void
+  attach(
+    const McMatrix& matrix ///< [in] 対象の行列
+  );
+
+  /// @brief 登録を解除する．
+  void
+  detach();
+
+  /// @brief 登録されている行列を返す．
+  ///
+  /// 登録されていない時は nullptr を返す．
+  const McMatrix*
+  observed_matrix() const
+  {
+    return mMatrix;
+  }
+
+  /// @brief 行が削除された時に呼ばれる関数
+  virtual
+  void
+  rows_deleted(
+    const vector<SizeType>& row_list ///< [in] 削除された行番号のリスト
+  );
+
+  /// @brief 列が削除された時に呼ばれる関数
+  virtual
+  void
+  cols_deleted(
+    const vector<SizeType>& col_list ///< [in] 削除された列番号のリスト
+  );
+
+  /// @brief 行が復元された時に呼ばれる関数
+  virtual
+  void
+  rows_restored(
+    const vector<SizeType>& row_list ///< [in] 復元された行番号のリスト
+  );
+
+  /// @brief 列が復元された時に呼ばれる関数
+  virtual
+  void
+  cols_restored(
+    const vector<SizeType>& col_list ///< [in] 復元された列番号のリスト
+  );
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 登録されている行列
+  const McMatrix* mMatrix{nullptr};
+
+};
+
+
+//////////////////////////////////////////////////////////////////////
+/// @class McObserverList McObserver.h "mincov/McObserver.h"
+/// @brief McMatrix に登録された McObserver のリスト
+///
+/// McMatrix のデータメンバとして用いる．
+/// 登録は特定の行列に対するものなので，コピーされた行列には引き継がない．
+/// 破棄される時には登録されていたオブジェクトの登録を外す．
+//////////////////////////////////////////////////////////////////////
+class McObserverList
+{
+public:
+
+  /// @brief コンストラクタ
+  McObserverList() = default;
+
+  /// @brief コピーコンストラクタ
+  ///
+  /// 空のリストとなる．
+  McObserverList(
+    const McObserverList& src ///< [in] コピー元のオブジェクト
+  )
+  {
+  }
+
+  /// @brief コピー代入演算子
+  ///
+  /// 内容が置き換わるので登録をすべて外す．
+  McObserverList&
+  operator=(
+    const McObserverList& src ///< [in] コピー元のオブジェクト
+  )
+  {
+    clear();
+    return *this;
+  }
+
+  /// @brief デストラクタ
+  ~McObserverList()
+  {
+    clear();
+  }
+
+
+public:
+  //////////////////////////////////////////////////////////////////////
+  // 外部インターフェイス
+  //////////////////////////////////////////////////////////////////////
+
+  /// @brief 空の時 true を返す．
+  bool
+  empty() const
+  {
+    return mList.empty();
+  }
+
+  /// @brief 登録する．
+  void
+  add(
+    const McMatrix* matrix, ///< [in] 登録先の行列
+    McObserver* observer    ///< [in] 登録するオブジェクト
+  );
+
+  /// @brief 登録を解除する．
+  void
+  remove(
+    McObserver* observer ///< [in] 解除するオブジェクト
+  );
+
+  /// @brief すべての登録を解除する．
+  void
+  clear();
+
+  /// @brief 先頭の反復子を返す．
+  vector<McObserver*>::const_iterator
+  begin() const
+  {
+    return mList.begin();
+  }
+
+  /// @brief 末尾の反復子を返す．
+  vector<McObserver*>::const_iterator
+  end() const
+  {
+    return mList.end();
+  }
+
+
+private:
+  //////////////////////////////////////////////////////////////////////
+  // データメンバ
+  //////////////////////////////////////////////////////////////////////
+
+  // 登録されているオブジェクトのリスト
+  vector<McObserver*> mList;
+
+  // 登録の変更を排他するためのミューテックス
+  std::mutex mMutex;
+
+};
+
+END_NAMESPACE_YM_MINCOV
+
+#endif // YM_MCOBSERVER_H
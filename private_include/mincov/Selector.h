@@ -47,6 +47,30 @@ public:
     const McMatrix& matrix ///< [in] 対象の行列
   ) = 0;
 
+  /// @brief 列ごとの評価値を持つ時 true を返す．
+  ///
+  /// true の時は select() は score() が最大の列を選ぶ．
+  virtual
+  bool
+  has_score() const
+  {
+    return false;
+  }
+
+  /// @brief 列の評価値を返す．
+  ///
+  /// has_score() が true の時だけ意味を持つ．
+  /// 評価値は行列の状態から毎回計算される．
+  virtual
+  double
+  score(
+    const McMatrix& matrix, ///< [in] 対象の行列
+    SizeType col_pos        ///< [in] 列番号
+  ) const
+  {
+    return 0.0;
+  }
+
 };
 
 END_NAMESPACE_YM_MINCOV
@@ -26,7 +26,9 @@ class McRowList;
 class McColList;
 class McColComp;
 class McMatrix;
+class McBlock;
 class McHeadList;
+class McObserver;
 
 END_NAMESPACE_YM_MINCOV
 